@@ -10,7 +10,13 @@
 #include "./lib/ssd1306.h"
 #include "./lib/font.h"
 #include "./lib/frames.h"
-#include "pio_matrix.pio.h"
+#include "./lib/telemetry.h"
+#include "./lib/joystick.h"
+#include "./lib/screen_cache.h"
+#include "./lib/led_matrix.h"
+#include "./lib/presenter.h"
+#include "./lib/game_core.h"
+#include "./lib/clock_profile.h"
 
 // Comunicação Serial I2C
 #define I2C_PORT i2c1
@@ -19,13 +25,19 @@
 
 // Definições do Display
 #define SSD_ADDR 0x3C
-#define SSD_WIDTH 128
-#define SSD_HEIGHT 64
+#define SSD_WIDTH WIDTH   // Geometria vem de DISPLAY_PANEL (lib/display.h)
+#define SSD_HEIGHT HEIGHT
+// Linhas de texto alinhadas às páginas do display
+#define TEXT_ROW_TOP (SSD_HEIGHT / 4)          // 16 no painel de 64 linhas
+#define TEXT_ROW_MIDDLE (SSD_HEIGHT / 2)       // 32
+#define TEXT_ROW_BOTTOM (SSD_HEIGHT * 3 / 4)   // 48
+#define TEXT_CENTER_X(chars) ((SSD_WIDTH - (chars) * 8) / 2)
+#define LEVEL_FIELD_CHARS 3 // MAX_LEVEL tem 3 dígitos
+#define ROUND_FIELD_CHARS 5
 #define SQUARE_SIZE 8
 
-// Definições do PWM para Buzzers (2 kHz)
-#define BUZZER_WRAP 62500
-#define BUZZER_CLK_DIV 1.0
+// Definições do PWM para Buzzers; divisor e wrap saem do clk_sys do perfil
+#define BUZZER_FREQ_HZ 2000
 #define BUZZER_START_MS 100
 
 // Buzzers
@@ -37,82 +49,92 @@
 #define RGB_GREEN_PIN 11
 #define RGB_BLUE_PIN 12
 #define RGB_PWM_WRAP 255
-#define RGB_CLK_DIV 1.0
+#define RGB_PWM_HZ 488281 // 125 MHz / 256, como no divisor 1 original
 
 // Matriz de LEDs
 #define MATRIZ_LEDS_PIN 7
-#define NUM_LEDS 25
 
 // Joystick
 #define JOY_X_PIN 27 // ADC0
 #define JOY_Y_PIN 26 // ADC1
+#define JOY_CALIBRATION_SAMPLES 32 // Amostras do centro no boot (manche solto)
 #define BUTTON_CONFIRM_PIN 6
 
 // Definições do Jogo
-#define MAX_SEQUENCE 20
-#define BASE_TIME_LIMIT_MS 10000 // 10s inicial
-#define TIME_DECREMENT_MS 200 // Decremento por nível
-#define MIN_TIME_LIMIT_MS 6000 // 6s mínimo
-#define ROUNDS_PER_LEVEL 5
-#define JOY_MARGIN 300
-#define JOY_UP_MIN (4095 - JOY_MARGIN)
-#define JOY_DOWN_MAX JOY_MARGIN
-#define JOY_LEFT_MAX JOY_MARGIN
-#define JOY_RIGHT_MIN (4095 - JOY_MARGIN)
-#define BASE_REACTION_MS 3500
-#define REACTION_DECREMENT_MS 100
-#define MIN_REACTION_MS 2000
+// Regras e tempos por nível ficam em lib/game_core.h
 #define REACTION_GAMEOVER_MS 4000
-#define BASE_ARROW_DISPLAY_MS 2000
-#define ARROW_DECREMENT_MS 50
-#define MIN_ARROW_DISPLAY_MS 1000
 #define ARROW_PAUSE_MS 200
+#define SEQUENCE_LEAD_US 5000 // Folga entre montar a linha do tempo e a primeira seta
 #define LEVEL_DISPLAY_MS 1000
+#define BENCH_ITERATIONS 16 // Repetições das medidas de CPU por troca de perfil
 
 // Frames das setas e reações
 extern float arrow_frames[4][5][5];
 extern float reaction_frames[3][5][5];
 
-// Estrutura do estado do jogo
+// Eventos de mudança que acionam a saída durante a entrada do jogador
+#define OUTPUT_EVT_DIRECTION 0x01
+#define OUTPUT_EVT_SQUARE 0x02
+
+// Último estado enviado à matriz e ao OLED, com contadores da sessão
 typedef struct {
-    uint8_t lives;
-    uint8_t sequence[MAX_SEQUENCE];
-    uint8_t player_sequence[MAX_SEQUENCE];
-    uint8_t sequence_length;
-    uint8_t player_steps;
-    uint32_t rounds;
-    uint8_t difficulty_level;
-    bool game_over;
-} GameState;
+    bool valid; // false força o envio na próxima verificação
+    uint8_t arrow; // JOY_DIR_NONE = matriz apagada
+    uint8_t square_x;
+    uint8_t square_y;
+    uint32_t matrix_frames;
+    uint32_t matrix_skipped;
+    uint32_t oled_frames;
+    uint32_t oled_skipped;
+    uint32_t inputs;
+    uint32_t input_latency_sum_us; // Do IRQ do botão até a entrada ser tratada
+    uint32_t input_latency_max_us;
+} OutputState;
 
 // Variáveis globais
 ssd1306_t ssd;
-PIO pio = pio0;
-uint sm;
 GameState game;
+joystick_t joy;
+OutputState output;
+screen_t title_screen;
+screen_t level_screen;
+screen_t game_over_screen;
+uint8_t level_slot, round_slot;
+uint8_t game_over_round_slot, game_over_level_slot;
 volatile bool button_confirm_pressed = false;
+volatile uint32_t button_press_us = 0;
+uint16_t buzzer_wrap;
 
 // Protótipos
 void setup();
 void init_buttons();
 void init_buzzers();
 void init_rgb();
+void config_buzzer_pwm();
+void config_rgb_pwm();
+void apply_clock_profile(clock_profile_t profile);
+void benchmark_clock_profile();
+void select_clock_profile();
+void draw_title();
 void init_joystick();
 void init_i2c_display();
 void init_matrix_leds();
+void build_screens();
 void button_irq_handler(uint gpio, uint32_t events);
+void render_arrow(matrix_frame_t *frame, uint8_t arrow_index);
+void render_reaction(matrix_frame_t *frame, uint8_t reaction_index, float r, float g, float b);
 void display_arrow(uint8_t arrow_index);
 void display_reaction(uint8_t reaction_index, float r, float g, float b);
 void start_buzzer();
 void update_rgb_lives();
 void update_oled_square();
+void invalidate_outputs();
+uint8_t detect_output_events();
 void reset_game();
 void generate_sequence();
 uint32_t matrix_led_color(float red, float green, float blue);
-uint32_t get_time_limit();
-uint32_t get_arrow_display_time();
-uint32_t get_reaction_time();
 void read_joystick(uint16_t *joy_x, uint16_t *joy_y);
+void sample_joystick();
 void clear_matrix();
 void update_dynamic_arrow();
 void show_level();
@@ -122,34 +144,28 @@ void show_reaction(bool success);
 void show_game_over();
 
 int main() {
+    clock_profile_set(CLOCK_PROFILE_BOOT); // Antes dos periféricos calcularem divisores
     stdio_init_all();
+    telemetry_init();
+    telemetry_boot(); // Primeiro quadro da sessão, antes das métricas do setup
     setup();
     reset_game();
 
     // Tela inicial
-    ssd1306_fill(&ssd, false);
-    ssd1306_draw_string(&ssd, "JOGO DE SETAS", (SSD_WIDTH/2) - ((sizeof("JOGO DE SETAS") * 8) / 2), 20);
-    ssd1306_draw_string(&ssd, "Pressione Botao", (SSD_WIDTH/2) - ((sizeof("Pressione Botao") * 8) / 2), 40);
-    ssd1306_send_data(&ssd);
-
-    while (!button_confirm_pressed) tight_loop_contents();
-    button_confirm_pressed = false;
+    select_clock_profile();
 
     while (true) {
+        telemetry_task();
         show_level();
         show_sequence();
         bool success = player_input();
         show_reaction(success);
-        if (game.lives == 0) {
+        if (game.game_over) {
             show_game_over();
             reset_game();
+            select_clock_profile(); // Volta à tela inicial, onde o perfil pode mudar
         } else {
-            game.rounds++;
-            game.difficulty_level = (game.rounds / ROUNDS_PER_LEVEL) + 1;
-            game.sequence_length = game.difficulty_level;
-            if (game.sequence_length > MAX_SEQUENCE) {
-                game.sequence_length = MAX_SEQUENCE;
-            }
+            game_advance(&game);
         }
     }
 }
@@ -161,6 +177,7 @@ void setup() {
     init_joystick();
     init_matrix_leds();
     init_i2c_display();
+    build_screens();
 }
 
 void init_buttons() {
@@ -174,8 +191,7 @@ void init_buzzers() {
     gpio_set_function(BUZZER_A_PIN, GPIO_FUNC_PWM);
     gpio_set_function(BUZZER_B_PIN, GPIO_FUNC_PWM);
     uint buzzer_slice = pwm_gpio_to_slice_num(BUZZER_A_PIN);
-    pwm_set_clkdiv(buzzer_slice, BUZZER_CLK_DIV);
-    pwm_set_wrap(buzzer_slice, BUZZER_WRAP);
+    config_buzzer_pwm();
     pwm_set_chan_level(buzzer_slice, PWM_CHAN_A, 0);
     pwm_set_chan_level(buzzer_slice, PWM_CHAN_B, 0);
     pwm_set_enabled(buzzer_slice, false);
@@ -187,32 +203,135 @@ void init_rgb() {
     gpio_set_function(RGB_BLUE_PIN, GPIO_FUNC_PWM);
     uint slice_red_green = pwm_gpio_to_slice_num(RGB_RED_PIN);
     uint slice_blue = pwm_gpio_to_slice_num(RGB_BLUE_PIN);
-    pwm_set_clkdiv(slice_red_green, RGB_CLK_DIV);
-    pwm_set_wrap(slice_red_green, RGB_PWM_WRAP);
+    config_rgb_pwm();
     pwm_set_chan_level(slice_red_green, PWM_CHAN_A, 0);
     pwm_set_chan_level(slice_red_green, PWM_CHAN_B, 0);
-    pwm_set_clkdiv(slice_blue, RGB_CLK_DIV);
-    pwm_set_wrap(slice_blue, RGB_PWM_WRAP);
     pwm_set_chan_level(slice_blue, PWM_CHAN_A, 0);
     pwm_set_enabled(slice_red_green, true);
     pwm_set_enabled(slice_blue, true);
 }
 
+// Buzzers em 2 kHz no clk_sys atual; o wrap muda com o perfil
+void config_buzzer_pwm() {
+    uint buzzer_slice = pwm_gpio_to_slice_num(BUZZER_A_PIN);
+    float div;
+    buzzer_wrap = clock_profile_pwm_wrap(BUZZER_FREQ_HZ, &div);
+    pwm_set_clkdiv(buzzer_slice, div);
+    pwm_set_wrap(buzzer_slice, buzzer_wrap);
+}
+
+// Wrap fixo: os níveis de update_rgb_lives() continuam valendo
+void config_rgb_pwm() {
+    float div = clock_profile_pwm_div(RGB_PWM_HZ, RGB_PWM_WRAP);
+    uint slice_red_green = pwm_gpio_to_slice_num(RGB_RED_PIN);
+    uint slice_blue = pwm_gpio_to_slice_num(RGB_BLUE_PIN);
+    pwm_set_clkdiv(slice_red_green, div);
+    pwm_set_wrap(slice_red_green, RGB_PWM_WRAP);
+    pwm_set_clkdiv(slice_blue, div);
+    pwm_set_wrap(slice_blue, RGB_PWM_WRAP);
+}
+
+// Troca o clk_sys e recalcula todo divisor que depende dele
+void apply_clock_profile(clock_profile_t profile) {
+    led_matrix_wait(); // Nenhum bit da matriz em trânsito durante a troca
+    ssd1306_wait(&ssd);
+    if (!clock_profile_set(profile)) return;
+    config_buzzer_pwm();
+    config_rgb_pwm();
+    led_matrix_retime();
+    i2c_set_baudrate(I2C_PORT, clock_profile_i2c_hz());
+}
+
+// Custos por frame no perfil atual. Termina com a tela inicial desenhada e
+// enviada ao OLED.
+void benchmark_clock_profile() {
+    static const matrix_frame_t blank = {0};
+    matrix_frame_t frame;
+
+    // Montagem da tela de nível, como em show_level()
+    uint32_t start = time_us_32();
+    for (uint8_t i = 0; i < BENCH_ITERATIONS; i++) {
+        screen_cache_load(&level_screen, &ssd);
+        screen_cache_patch_number(&level_screen, &ssd, level_slot, 888);
+        screen_cache_patch_number(&level_screen, &ssd, round_slot, 88888);
+    }
+    uint32_t oled_render_us = (time_us_32() - start) / BENCH_ITERATIONS;
+
+    // Renderização de uma seta mais a cópia para o buffer do DMA; o envio
+    // em si segue a taxa fixa do WS2812 e fica de fora
+    start = time_us_32();
+    for (uint8_t i = 0; i < BENCH_ITERATIONS; i++) render_arrow(&frame, i % 4);
+    uint32_t render_us = (time_us_32() - start) / BENCH_ITERATIONS;
+    led_matrix_wait();
+    start = time_us_32();
+    led_matrix_show(&blank);
+    uint32_t matrix_render_us = render_us + (time_us_32() - start);
+
+    // Envio de um frame completo ao OLED, limitado pela taxa do I2C
+    draw_title();
+    start = time_us_32();
+    ssd1306_send_data(&ssd);
+    ssd1306_wait(&ssd);
+    uint32_t oled_flush_us = time_us_32() - start;
+
+    telemetry_metric(TLM_METRIC_CLOCK_PROFILE, clock_profile_current());
+    telemetry_metric(TLM_METRIC_SYS_CLOCK_KHZ, clock_profile_sys_khz());
+    telemetry_metric(TLM_METRIC_I2C_HZ, clock_profile_i2c_hz());
+    telemetry_metric(TLM_METRIC_OLED_RENDER_US, oled_render_us);
+    telemetry_metric(TLM_METRIC_OLED_FLUSH_US, oled_flush_us);
+    telemetry_metric(TLM_METRIC_MATRIX_RENDER_US, matrix_render_us);
+}
+
+void draw_title() {
+    const char *name = clock_profile_name(clock_profile_current());
+    screen_cache_load(&title_screen, &ssd);
+    ssd1306_draw_string(&ssd, name, TEXT_CENTER_X(strlen(name)), TEXT_ROW_MIDDLE);
+}
+
+// Tela inicial: esquerda/direita no joystick troca o perfil de clock até o
+// botão ser pressionado
+void select_clock_profile() {
+    uint8_t last = JOY_DIR_NONE;
+    benchmark_clock_profile(); // Também exibe a tela
+    while (!button_confirm_pressed) {
+        sample_joystick();
+        if (joy.direction != last) {
+            last = joy.direction;
+            int step = (last == JOY_DIR_RIGHT) ? 1 : (last == JOY_DIR_LEFT) ? -1 : 0;
+            if (step) {
+                apply_clock_profile((clock_profile_t)((clock_profile_current() + CLOCK_PROFILE_COUNT + step) % CLOCK_PROFILE_COUNT));
+                benchmark_clock_profile();
+            }
+        }
+        telemetry_task();
+        sleep_ms(10);
+    }
+    button_confirm_pressed = false;
+}
+
 void init_joystick() {
     adc_init();
     adc_gpio_init(JOY_X_PIN);
     adc_gpio_init(JOY_Y_PIN);
+
+    // Calibra o centro com o manche em repouso
+    uint32_t sum_x = 0, sum_y = 0;
+    for (int i = 0; i < JOY_CALIBRATION_SAMPLES; i++) {
+        uint16_t joy_x, joy_y;
+        read_joystick(&joy_x, &joy_y);
+        sum_x += joy_x;
+        sum_y += joy_y;
+        sleep_ms(1);
+    }
+    joystick_calibrate(&joy, sum_x / JOY_CALIBRATION_SAMPLES, sum_y / JOY_CALIBRATION_SAMPLES);
 }
 
 void init_matrix_leds() {
-    sm = pio_claim_unused_sm(pio, true);
-    uint offset = pio_add_program(pio, &pio_matrix_program);
-    pio_matrix_program_init(pio, sm, offset, MATRIZ_LEDS_PIN);
-    pio_sm_set_enabled(pio, sm, true);
+    led_matrix_init(pio0, MATRIZ_LEDS_PIN);
 }
 
 void init_i2c_display() {
-    i2c_init(I2C_PORT, 400000);
+    i2c_init(I2C_PORT, clock_profile_i2c_hz());
     gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_I2C);
     gpio_set_function(I2C_SCL_PIN, GPIO_FUNC_I2C);
     gpio_pull_up(I2C_SDA_PIN);
@@ -223,55 +342,100 @@ void init_i2c_display() {
     ssd1306_send_data(&ssd);
 }
 
+// Renderiza as telas fixas uma vez; depois exibi-las é cópia + envio
+void build_screens() {
+    int16_t x;
+    memset(&title_screen, 0, sizeof(title_screen));
+    memset(&level_screen, 0, sizeof(level_screen));
+    memset(&game_over_screen, 0, sizeof(game_over_screen));
+    screen_cache_reset();
+
+    ssd1306_fill(&ssd, false);
+    ssd1306_draw_string(&ssd, "JOGO DE SETAS", TEXT_CENTER_X(13), TEXT_ROW_TOP);
+    ssd1306_draw_string(&ssd, "Pressione Botao", TEXT_CENTER_X(15), TEXT_ROW_BOTTOM);
+    bool ok = screen_cache_capture(&title_screen, &ssd, false);
+
+    // "Nivel: NNN" / "Rodada: NNNNN"
+    ssd1306_fill(&ssd, false);
+    x = TEXT_CENTER_X(7 + LEVEL_FIELD_CHARS);
+    ssd1306_draw_string(&ssd, "Nivel:", x, TEXT_ROW_TOP);
+    level_slot = screen_cache_add_slot(&level_screen, x + 7 * 8, TEXT_ROW_TOP, LEVEL_FIELD_CHARS);
+    x = TEXT_CENTER_X(8 + ROUND_FIELD_CHARS);
+    ssd1306_draw_string(&ssd, "Rodada:", x, TEXT_ROW_BOTTOM);
+    round_slot = screen_cache_add_slot(&level_screen, x + 8 * 8, TEXT_ROW_BOTTOM, ROUND_FIELD_CHARS);
+    ok &= screen_cache_capture(&level_screen, &ssd, true);
+
+    // "GAME OVER" / "Rounds: NNNNN" / "Nivel: NNN"
+    ssd1306_fill(&ssd, false);
+    ssd1306_draw_string(&ssd, "GAME OVER", TEXT_CENTER_X(9), TEXT_ROW_TOP);
+    x = TEXT_CENTER_X(8 + ROUND_FIELD_CHARS);
+    ssd1306_draw_string(&ssd, "Rounds:", x, TEXT_ROW_MIDDLE);
+    game_over_round_slot = screen_cache_add_slot(&game_over_screen, x + 8 * 8, TEXT_ROW_MIDDLE, ROUND_FIELD_CHARS);
+    x = TEXT_CENTER_X(7 + LEVEL_FIELD_CHARS);
+    ssd1306_draw_string(&ssd, "Nivel:", x, TEXT_ROW_BOTTOM);
+    game_over_level_slot = screen_cache_add_slot(&game_over_screen, x + 7 * 8, TEXT_ROW_BOTTOM, LEVEL_FIELD_CHARS);
+    ok &= screen_cache_capture(&game_over_screen, &ssd, true);
+
+    if (!ok) panic("screen cache: SCREEN_CACHE_POOL_SIZE insuficiente");
+    telemetry_metric(TLM_METRIC_SCREEN_CACHE_BYTES, screen_cache_used());
+    ssd1306_fill(&ssd, false);
+}
+
 void button_irq_handler(uint gpio, uint32_t events) {
     static uint32_t last_time = 0;
     uint32_t current_time = to_ms_since_boot(get_absolute_time());
     if (current_time - last_time >= 300) {
         if (gpio == BUTTON_CONFIRM_PIN) {
+            button_press_us = time_us_32();
             button_confirm_pressed = true;
         }
         last_time = current_time;
     }
 }
 
-void display_arrow(uint8_t arrow_index) {
-    uint32_t colors[NUM_LEDS] = {0};
+void render_arrow(matrix_frame_t *frame, uint8_t arrow_index) {
+    memset(frame, 0, sizeof(*frame));
     for (uint8_t row = 0; row < 5; row++) {
         for (uint8_t col = 0; col < 5; col++) {
             if (arrow_frames[arrow_index][row][col] > 0) {
-                colors[row * 5 + col] = matrix_led_color(0.0, 0.0, 1.0); // Azul
+                frame->pixels[row * 5 + col] = matrix_led_color(0.0, 0.0, 1.0); // Azul
             }
         }
     }
-    for (uint8_t i = 0; i < NUM_LEDS; i++) {
-        pio_sm_put_blocking(pio, sm, colors[i]);
-    }
 }
 
-void display_reaction(uint8_t reaction_index, float r, float g, float b) {
-    uint32_t colors[NUM_LEDS] = {0};
+void render_reaction(matrix_frame_t *frame, uint8_t reaction_index, float r, float g, float b) {
+    memset(frame, 0, sizeof(*frame));
     for (uint8_t row = 0; row < 5; row++) {
         for (uint8_t col = 0; col < 5; col++) {
             if (reaction_frames[reaction_index][4 - row][col] > 0) {
-                colors[row * 5 + col] = matrix_led_color(r, g, b);
+                frame->pixels[row * 5 + col] = matrix_led_color(r, g, b);
             }
         }
     }
-    for (uint8_t i = 0; i < NUM_LEDS; i++) {
-        pio_sm_put_blocking(pio, sm, colors[i]);
-    }
+}
+
+void display_arrow(uint8_t arrow_index) {
+    matrix_frame_t frame;
+    render_arrow(&frame, arrow_index);
+    led_matrix_show(&frame);
+}
+
+void display_reaction(uint8_t reaction_index, float r, float g, float b) {
+    matrix_frame_t frame;
+    render_reaction(&frame, reaction_index, r, g, b);
+    led_matrix_show(&frame);
 }
 
 void clear_matrix() {
-    for (uint8_t i = 0; i < NUM_LEDS; i++) {
-        pio_sm_put_blocking(pio, sm, 0);
-    }
+    static const matrix_frame_t blank = {0};
+    led_matrix_show(&blank);
 }
 
 void start_buzzer() {
     uint buzzer_slice = pwm_gpio_to_slice_num(BUZZER_A_PIN);
-    pwm_set_chan_level(buzzer_slice, PWM_CHAN_A, BUZZER_WRAP / 4);
-    pwm_set_chan_level(buzzer_slice, PWM_CHAN_B, BUZZER_WRAP / 4);
+    pwm_set_chan_level(buzzer_slice, PWM_CHAN_A, buzzer_wrap / 4);
+    pwm_set_chan_level(buzzer_slice, PWM_CHAN_B, buzzer_wrap / 4);
     pwm_set_enabled(buzzer_slice, true);
     sleep_ms(BUZZER_START_MS);
     pwm_set_enabled(buzzer_slice, false);
@@ -297,63 +461,62 @@ void update_rgb_lives() {
 }
 
 void update_oled_square() {
-    static uint8_t current_pos_x = (SSD_HEIGHT / 2) - (SQUARE_SIZE / 2);
-    static uint8_t current_pos_y = (SSD_WIDTH / 2) - (SQUARE_SIZE / 2);
-    uint16_t joy_x, joy_y;
-    read_joystick(&joy_x, &joy_y);
+    ssd1306_fill(&ssd, false);
+    ssd1306_rect(&ssd, output.square_x, output.square_y, SQUARE_SIZE, SQUARE_SIZE, true, true);
+    ssd1306_send_data(&ssd);
+    output.oled_frames++;
+}
 
+// Força o próximo envio; usado quando outra tela ou frame sobrescreveu a saída
+void invalidate_outputs() {
+    output.valid = false;
+}
+
+// Compara o estado do joystick com o último enviado e retorna o que mudou
+uint8_t detect_output_events() {
+    uint8_t events = 0;
     uint mov_div_x = 4096 / SSD_HEIGHT;
     uint mov_div_y = 4096 / SSD_WIDTH;
+    uint8_t new_pos_x = (uint8_t)((4095 - joy.filt_x) / mov_div_x);
+    uint8_t new_pos_y = (uint8_t)(joy.filt_y / mov_div_y);
+    uint8_t square_x = output.square_x;
+    uint8_t square_y = output.square_y;
+
+    if (new_pos_x <= SSD_HEIGHT - SQUARE_SIZE) square_x = new_pos_x;
+    if (new_pos_y <= SSD_WIDTH - SQUARE_SIZE) square_y = new_pos_y;
+
+    if (!output.valid || square_x != output.square_x || square_y != output.square_y) {
+        output.square_x = square_x;
+        output.square_y = square_y;
+        events |= OUTPUT_EVT_SQUARE;
+    } else {
+        output.oled_skipped++;
+    }
 
-    ssd1306_fill(&ssd, false);
-    uint8_t new_pos_x = (uint8_t)((4095 - joy_x) / mov_div_x);
-    uint8_t new_pos_y = (uint8_t)(joy_y / mov_div_y);
-
-    if (new_pos_x <= SSD_HEIGHT - SQUARE_SIZE) current_pos_x = new_pos_x;
-    if (new_pos_y <= SSD_WIDTH - SQUARE_SIZE) current_pos_y = new_pos_y;
+    if (!output.valid || joy.direction != output.arrow) {
+        output.arrow = joy.direction;
+        events |= OUTPUT_EVT_DIRECTION;
+    } else {
+        output.matrix_skipped++;
+    }
 
-    ssd1306_rect(&ssd, current_pos_x, current_pos_y, SQUARE_SIZE, SQUARE_SIZE, true, true);
-    ssd1306_send_data(&ssd);
+    output.valid = true;
+    return events;
 }
 
 void reset_game() {
-    game.lives = 3;
-    game.sequence_length = 1;
-    game.player_steps = 0;
-    game.rounds = 0;
-    game.difficulty_level = 1;
-    game.game_over = false;
-    memset(game.sequence, 0, MAX_SEQUENCE);
-    memset(game.player_sequence, 0, MAX_SEQUENCE);
+    game_reset(&game);
+    memset(&output, 0, sizeof(output));
+    output.square_x = (SSD_HEIGHT / 2) - (SQUARE_SIZE / 2);
+    output.square_y = (SSD_WIDTH / 2) - (SQUARE_SIZE / 2);
     update_rgb_lives();
     button_confirm_pressed = false;
     clear_matrix();
 }
 
 void generate_sequence() {
-    memset(game.sequence, 0, MAX_SEQUENCE);
-    memset(game.player_sequence, 0, MAX_SEQUENCE);
-    // Inicializa srand com o tempo atual para maior aleatoriedade
-    srand(to_ms_since_boot(get_absolute_time()));
-    for (uint8_t i = 0; i < game.sequence_length; i++) {
-        game.sequence[i] = rand() % 4; // 0 a 3 para direções diferentes
-    }
-    game.player_steps = 0;
-}
-
-uint32_t get_time_limit() {
-    uint32_t time_limit = BASE_TIME_LIMIT_MS - (game.difficulty_level * TIME_DECREMENT_MS);
-    return time_limit < MIN_TIME_LIMIT_MS ? MIN_TIME_LIMIT_MS : time_limit;
-}
-
-uint32_t get_arrow_display_time() {
-    uint32_t display_time = BASE_ARROW_DISPLAY_MS - (game.difficulty_level * ARROW_DECREMENT_MS);
-    return display_time < MIN_ARROW_DISPLAY_MS ? MIN_ARROW_DISPLAY_MS : display_time;
-}
-
-uint32_t get_reaction_time() {
-    uint32_t reaction_time = BASE_REACTION_MS - (game.difficulty_level * REACTION_DECREMENT_MS);
-    return reaction_time < MIN_REACTION_MS ? MIN_REACTION_MS : reaction_time;
+    // Semente com o tempo atual para maior aleatoriedade
+    game_generate_sequence(&game, time_us_32());
 }
 
 uint32_t matrix_led_color(float red, float green, float blue) {
@@ -364,108 +527,134 @@ uint32_t matrix_led_color(float red, float green, float blue) {
 }
 
 void read_joystick(uint16_t *joy_x, uint16_t *joy_y) {
-    uint32_t sum_x = 0, sum_y = 0;
-    const int samples = 3;
-    for (int i = 0; i < samples; i++) {
-        adc_select_input(0);
-        sum_x += adc_read();
-        adc_select_input(1);
-        sum_y += adc_read();
-    }
-    *joy_x = sum_x / samples;
-    *joy_y = sum_y / samples;
+    adc_select_input(0);
+    *joy_x = adc_read();
+    adc_select_input(1);
+    *joy_y = adc_read();
 }
 
-void update_dynamic_arrow() {
+// Uma amostra por tick; filtragem e classificação ficam em joystick_update()
+void sample_joystick() {
     uint16_t joy_x, joy_y;
     read_joystick(&joy_x, &joy_y);
-    if (joy_x >= JOY_UP_MIN) display_arrow(1); // Baixo
-    else if (joy_x <= JOY_DOWN_MAX) display_arrow(0); // Cima
-    else if (joy_y <= JOY_LEFT_MAX) display_arrow(2); // Esquerda
-    else if (joy_y >= JOY_RIGHT_MIN) display_arrow(3); // Direita
+    joystick_update(&joy, joy_x, joy_y);
+#ifdef JOYSTICK_TRACE
+    telemetry_joy_sample(joy_x, joy_y, joy.direction, joy.confidence);
+#endif
+}
+
+void update_dynamic_arrow() {
+    if (output.arrow != JOY_DIR_NONE) display_arrow(output.arrow);
     else clear_matrix();
+    output.matrix_frames++;
 }
 
 void show_level() {
-    char buffer[20];
-    snprintf(buffer, sizeof(buffer), "Nivel: %u Rodada: %lu", game.difficulty_level, game.rounds + 1);
-    ssd1306_fill(&ssd, false);
-    ssd1306_draw_string(&ssd, buffer, (SSD_WIDTH/2) - ((strlen(buffer) * 8) / 2), 30);
+    screen_cache_load(&level_screen, &ssd);
+    screen_cache_patch_number(&level_screen, &ssd, level_slot, game.difficulty_level);
+    screen_cache_patch_number(&level_screen, &ssd, round_slot, game.rounds + 1);
     ssd1306_send_data(&ssd);
-    printf("Nível: %u, Rodada: %lu\n", game.difficulty_level, game.rounds + 1);
+    telemetry_level(game.difficulty_level, game.rounds + 1);
+    telemetry_task();
     sleep_ms(LEVEL_DISPLAY_MS);
 }
 
+_Static_assert(2 * MAX_SEQUENCE <= PRESENTER_MAX_STEPS, "linha do tempo não cabe no presenter");
+
 void show_sequence() {
+    static matrix_frame_t arrows[4];
+    static const matrix_frame_t blank = {0};
+    static presenter_t presenter;
+
     generate_sequence();
+    uint32_t arrow_time = game_arrow_display_ms(&game);
+    uint32_t arrow_us = arrow_time * 1000;
+    uint32_t period_us = arrow_us + ARROW_PAUSE_MS * 1000;
+
+    // Frames e linha do tempo completos antes da primeira seta
+    for (uint8_t i = 0; i < 4; i++) render_arrow(&arrows[i], i);
+    presenter_clear(&presenter);
+    for (uint8_t i = 0; i < game.sequence_length; i++) {
+        presenter_add(&presenter, i * period_us, &arrows[game.sequence[i]]);
+        presenter_add(&presenter, i * period_us + arrow_us, &blank);
+        telemetry_arrow(i + 1, game.sequence_length, game.sequence[i], arrow_time);
+    }
+
+    if (!presenter_start(&presenter, SEQUENCE_LEAD_US)) {
+        // Nenhum alarme de hardware livre: apresenta sem alarmes
+        telemetry_metric(TLM_METRIC_PRESENTER_FALLBACK, 1);
+        presenter_run_blocking(&presenter);
+    }
+    while (!presenter_done(&presenter)) {
+        telemetry_task();
+        tight_loop_contents();
+    }
+    // Pausa após a última seta, contada do horário previsto
+    sleep_until(from_us_since_boot(presenter.start_us + game.sequence_length * period_us));
+
     for (uint8_t i = 0; i < game.sequence_length; i++) {
-        uint32_t arrow_time = get_arrow_display_time();
-        printf("Seta %u/%u: %lums (Direção=%u)\n", i + 1, game.sequence_length, arrow_time, game.sequence[i]);
-        display_arrow(game.sequence[i]);
-        sleep_ms(arrow_time);
-        clear_matrix();
-        sleep_ms(ARROW_PAUSE_MS);
+        telemetry_arrow_onset(i + 1, presenter.steps[2 * i].at_us, presenter_jitter_us(&presenter, 2 * i));
     }
 }
 
 bool player_input() {
     start_buzzer();
     game.player_steps = 0;
+    invalidate_outputs(); // Tela de nível e sequência sobrescreveram as saídas
     // Inicia o tempo após a sequência, quando entrada do jogador começa
     uint32_t start_time = to_ms_since_boot(get_absolute_time());
-    uint32_t time_limit = get_time_limit();
-    printf("Entrada do jogador, limite: %lums\n", time_limit);
+    // Toques durante nível, sequência ou reação não contam como entrada nem
+    // como latência
+    button_confirm_pressed = false;
+    telemetry_input_window(game_time_limit_ms(&game));
 
-    while (game.player_steps < game.sequence_length) {
+    while (!game_input_complete(&game)) {
         uint32_t current_time = to_ms_since_boot(get_absolute_time());
-        if (current_time - start_time > time_limit) {
-            game.lives--;
+        if (game_input_timed_out(&game, current_time - start_time)) {
+            game_finish_round(&game, true);
             update_rgb_lives();
-            printf("Timeout! Vidas: %u\n", game.lives);
+            telemetry_verdict(TLM_RESULT_TIMEOUT, game.lives);
             return false;
         }
 
-        update_oled_square();
-        update_dynamic_arrow();
+        sample_joystick();
+        uint8_t events = detect_output_events();
+        if (events & OUTPUT_EVT_SQUARE) update_oled_square();
+        if (events & OUTPUT_EVT_DIRECTION) update_dynamic_arrow();
 
         if (button_confirm_pressed) {
             button_confirm_pressed = false;
-            uint16_t joy_x, joy_y;
-            read_joystick(&joy_x, &joy_y);
-            uint8_t direction = 0;
-            if (joy_x >= JOY_UP_MIN) direction = 1;
-            else if (joy_x <= JOY_DOWN_MAX) direction = 0;
-            else if (joy_y <= JOY_LEFT_MAX) direction = 2;
-            else if (joy_y >= JOY_RIGHT_MIN) direction = 3;
-
-            game.player_sequence[game.player_steps] = direction;
-            game.player_steps++;
-            printf("Entrada %u: Direção=%u (Esperado=%u)\n", 
-                   game.player_steps, direction, game.sequence[game.player_steps - 1]);
+            uint32_t latency_us = time_us_32() - button_press_us;
+            output.inputs++;
+            output.input_latency_sum_us += latency_us;
+            if (latency_us > output.input_latency_max_us) output.input_latency_max_us = latency_us;
+            // Manche no centro conta como cima, como antes
+            uint8_t direction = (joy.direction != JOY_DIR_NONE) ? joy.direction : JOY_DIR_UP;
+
+            if (game_record_input(&game, direction)) {
+                telemetry_input(game.player_steps, direction, game.sequence[game.player_steps - 1]);
+            }
         }
+        telemetry_task();
         sleep_ms(10);
     }
 
-    for (uint8_t i = 0; i < game.sequence_length; i++) {
-        if (game.player_sequence[i] != game.sequence[i]) {
-            game.lives--;
-            update_rgb_lives();
-            printf("Erro! Vidas: %u\n", game.lives);
-            return false;
-        }
-    }
-    printf("Sucesso!\n");
-    return true;
+    game_verdict_t verdict = game_finish_round(&game, false);
+    update_rgb_lives();
+    telemetry_verdict((telemetry_result_t)verdict, game.lives);
+    return verdict == GAME_VERDICT_SUCCESS;
 }
 
 void show_reaction(bool success) {
-    uint32_t reaction_time = get_reaction_time();
+    uint32_t reaction_time = game_reaction_ms(&game);
     if (success) {
-        printf("Reação de sucesso: %lums\n", reaction_time);
+        telemetry_reaction(TLM_RESULT_SUCCESS, reaction_time);
+        telemetry_task();
         display_reaction(0, 0.0, 1.0, 0.0); // Verde
         sleep_ms(reaction_time);
     } else {
-        printf("Reação de erro: %lums\n", reaction_time);
+        telemetry_reaction(TLM_RESULT_WRONG, reaction_time);
+        telemetry_task();
         display_reaction(1, 1.0, 0.0, 0.0); // Vermelho
         sleep_ms(reaction_time);
     }
@@ -473,13 +662,21 @@ void show_reaction(bool success) {
 }
 
 void show_game_over() {
-    char buffer[20];
-    snprintf(buffer, sizeof(buffer), "Rounds: %lu Nivel: %u", game.rounds, game.difficulty_level);
-    ssd1306_fill(&ssd, false);
-    ssd1306_draw_string(&ssd, "GAME OVER", (SSD_WIDTH/2) - ((sizeof("GAME OVER") * 8) / 2), 20);
-    ssd1306_draw_string(&ssd, buffer, (SSD_WIDTH/2) - ((strlen(buffer) * 8) / 2), 40);
+    screen_cache_load(&game_over_screen, &ssd);
+    screen_cache_patch_number(&game_over_screen, &ssd, game_over_round_slot, game.rounds);
+    screen_cache_patch_number(&game_over_screen, &ssd, game_over_level_slot, game.difficulty_level);
     ssd1306_send_data(&ssd);
-    printf("Game Over: %lums\n", REACTION_GAMEOVER_MS);
+    telemetry_game_over(game.rounds, game.difficulty_level, REACTION_GAMEOVER_MS);
+    telemetry_metric(TLM_METRIC_MATRIX_FRAMES, output.matrix_frames);
+    telemetry_metric(TLM_METRIC_MATRIX_SKIPPED, output.matrix_skipped);
+    telemetry_metric(TLM_METRIC_OLED_FRAMES, output.oled_frames);
+    telemetry_metric(TLM_METRIC_OLED_SKIPPED, output.oled_skipped);
+    if (output.inputs) {
+        telemetry_metric(TLM_METRIC_INPUT_LATENCY_AVG_US, output.input_latency_sum_us / output.inputs);
+        telemetry_metric(TLM_METRIC_INPUT_LATENCY_MAX_US, output.input_latency_max_us);
+    }
+    telemetry_metric(TLM_METRIC_DROPPED_FRAMES, telemetry_dropped());
+    telemetry_task();
     display_reaction(2, 1.0, 0.0, 0.0); // Vermelho
     sleep_ms(REACTION_GAMEOVER_MS);
     clear_matrix();
@@ -0,0 +1,78 @@
+#include "clock_profile.h"
+#include "display.h"
+#include "hardware/clocks.h"
+#include "hardware/vreg.h"
+
+#define PWM_DIV_MAX (255.0f + 15.0f / 16.0f)
+
+typedef struct {
+    const char *name;
+    uint32_t sys_khz;
+    enum vreg_voltage vreg;
+    uint32_t i2c_hz; // Pedido do perfil; o aplicado é limitado por DISPLAY_MAX_I2C_HZ (400 kHz por padrão)
+} clock_profile_config_t;
+
+static const clock_profile_config_t profiles[CLOCK_PROFILE_COUNT] = {
+    [CLOCK_PROFILE_POWER_SAVE] = {"Economia", 48000, VREG_VOLTAGE_1_05, 400000},
+    [CLOCK_PROFILE_DEFAULT] = {"Padrao", 125000, VREG_VOLTAGE_1_10, 400000},
+    [CLOCK_PROFILE_PERFORMANCE] = {"Desempenho", 200000, VREG_VOLTAGE_1_15, 1000000},
+};
+
+static clock_profile_t current = CLOCK_PROFILE_DEFAULT;
+
+// Sobe a tensão antes de acelerar e só baixa depois de desacelerar
+bool clock_profile_set(clock_profile_t profile) {
+    if (profile >= CLOCK_PROFILE_COUNT) return false;
+    const clock_profile_config_t *next = &profiles[profile];
+    uint vco, postdiv1, postdiv2;
+    if (!check_sys_clock_khz(next->sys_khz, &vco, &postdiv1, &postdiv2)) return false;
+
+    bool faster = next->sys_khz > profiles[current].sys_khz;
+    if (faster) {
+        vreg_set_voltage(next->vreg);
+        sleep_us(100); // Estabilização do regulador
+    }
+    set_sys_clock_pll(vco, postdiv1, postdiv2);
+    if (!faster) vreg_set_voltage(next->vreg);
+    current = profile;
+    return true;
+}
+
+clock_profile_t clock_profile_current() {
+    return current;
+}
+
+const char *clock_profile_name(clock_profile_t profile) {
+    return profile < CLOCK_PROFILE_COUNT ? profiles[profile].name : "?";
+}
+
+uint32_t clock_profile_sys_khz() {
+    return clock_get_hz(clk_sys) / 1000;
+}
+
+uint32_t clock_profile_i2c_hz() {
+    uint32_t hz = profiles[current].i2c_hz;
+    return hz > DISPLAY_MAX_I2C_HZ ? DISPLAY_MAX_I2C_HZ : hz;
+}
+
+// Divisor para freq_hz com wrap fixo (brilho do LED RGB). Abaixo de 1 o
+// divisor satura e a frequência cai, o que não muda o brilho.
+float clock_profile_pwm_div(uint32_t freq_hz, uint32_t wrap) {
+    float div = (float)clock_get_hz(clk_sys) / ((float)freq_hz * (wrap + 1));
+    if (div < 1.0f) return 1.0f;
+    return div > PWM_DIV_MAX ? PWM_DIV_MAX : div;
+}
+
+// Menor divisor inteiro com wrap em 16 bits, para tons que precisam da
+// frequência exata (buzzer). Retorna o wrap; o duty deve partir dele.
+uint16_t clock_profile_pwm_wrap(uint32_t freq_hz, float *div) {
+    uint64_t sys = clock_get_hz(clk_sys);
+    uint64_t per_div = (uint64_t)freq_hz * 65536;
+    uint32_t d = (uint32_t)((sys + per_div - 1) / per_div);
+    if (d < 1) d = 1;
+    if (d > 255) d = 255;
+    *div = (float)d;
+    uint64_t wrap = sys / ((uint64_t)d * freq_hz);
+    if (wrap > 65536) wrap = 65536;
+    return (uint16_t)(wrap ? wrap - 1 : 0);
+}
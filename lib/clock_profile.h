@@ -0,0 +1,33 @@
+#ifndef CLOCK_PROFILE_H
+#define CLOCK_PROFILE_H
+
+#include "pico/stdlib.h"
+
+// Perfis de clock do sistema. Trocar o clk_sys também muda o clk_peri, então
+// quem usa divisores (PWM, PIO, I2C) precisa recalculá-los depois de
+// clock_profile_set(); os auxiliares abaixo partem do clk_sys atual.
+//
+// O perfil de boot vem do CMake (-DCLOCK_PROFILE=...); na tela inicial o
+// joystick troca o perfil em tempo de execução.
+
+typedef enum {
+    CLOCK_PROFILE_POWER_SAVE = 0,  // 48 MHz, núcleo em 1,05 V
+    CLOCK_PROFILE_DEFAULT = 1,     // 125 MHz
+    CLOCK_PROFILE_PERFORMANCE = 2, // 200 MHz, núcleo em 1,15 V; I2C a 1 MHz só se DISPLAY_MAX_I2C_HZ permitir
+    CLOCK_PROFILE_COUNT
+} clock_profile_t;
+
+#ifndef CLOCK_PROFILE_BOOT
+#define CLOCK_PROFILE_BOOT CLOCK_PROFILE_DEFAULT
+#endif
+
+bool clock_profile_set(clock_profile_t profile);
+clock_profile_t clock_profile_current();
+const char *clock_profile_name(clock_profile_t profile);
+uint32_t clock_profile_sys_khz();
+uint32_t clock_profile_i2c_hz();
+
+float clock_profile_pwm_div(uint32_t freq_hz, uint32_t wrap);
+uint16_t clock_profile_pwm_wrap(uint32_t freq_hz, float *div);
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+// Seleção do painel OLED em tempo de compilação (-DDISPLAY_PANEL=...).
+// Cada painel define geometria e particularidades do controlador; o driver
+// em ssd1306.c usa essas constantes, então o painel padrão não paga nada
+// pela abstração.
+
+#define DISPLAY_PANEL_SSD1306_128X64 0
+#define DISPLAY_PANEL_SSD1306_128X32 1
+#define DISPLAY_PANEL_SH1106_128X64 2
+
+#ifndef DISPLAY_PANEL
+#define DISPLAY_PANEL DISPLAY_PANEL_SSD1306_128X64
+#endif
+
+#if DISPLAY_PANEL == DISPLAY_PANEL_SSD1306_128X64
+#define WIDTH 128
+#define HEIGHT 64
+#define DISPLAY_SH1106 0
+#define DISPLAY_COL_OFFSET 0
+#define DISPLAY_COM_PIN_CFG 0x12
+#define DISPLAY_PANEL_I2C_HZ 400000 // Limite do datasheet do SSD1306
+#elif DISPLAY_PANEL == DISPLAY_PANEL_SSD1306_128X32
+#define WIDTH 128
+#define HEIGHT 32
+#define DISPLAY_SH1106 0
+#define DISPLAY_COL_OFFSET 0
+#define DISPLAY_COM_PIN_CFG 0x02
+#define DISPLAY_PANEL_I2C_HZ 400000
+#elif DISPLAY_PANEL == DISPLAY_PANEL_SH1106_128X64
+// SH1106 tem RAM de 132 colunas com o vidro centralizado e só aceita
+// endereçamento por página
+#define WIDTH 128
+#define HEIGHT 64
+#define DISPLAY_SH1106 1
+#define DISPLAY_COL_OFFSET 2
+#define DISPLAY_COM_PIN_CFG 0x12
+#define DISPLAY_PANEL_I2C_HZ 400000 // Limite do datasheet do SH1106
+#else
+#error "DISPLAY_PANEL desconhecido"
+#endif
+
+// Teto do barramento I2C para o painel. O padrão é o limite do datasheet;
+// 1 MHz (Fast-mode Plus) fica a critério de quem testou o módulo e os
+// pull-ups da placa: -DDISPLAY_MAX_I2C_HZ=1000000
+#ifndef DISPLAY_MAX_I2C_HZ
+#define DISPLAY_MAX_I2C_HZ DISPLAY_PANEL_I2C_HZ
+#endif
+
+#define DISPLAY_PAGES (HEIGHT / 8)
+#define DISPLAY_BUFSIZE (WIDTH * DISPLAY_PAGES + 1) // +1 para o byte de controle 0x40
+
+#endif
@@ -0,0 +1,97 @@
+#include <string.h>
+#include "game_core.h"
+
+// Limite inferior sem estouro de uint32 em níveis altos
+static uint32_t decay(uint32_t base, uint32_t step, uint8_t level, uint32_t minimum) {
+    uint32_t decrement = step * level;
+    if (decrement >= base || base - decrement < minimum) return minimum;
+    return base - decrement;
+}
+
+// xorshift32: determinístico para o simulador, barato no RP2040
+static uint32_t next_random(GameState *game) {
+    uint32_t x = game->rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    game->rng_state = x;
+    return x;
+}
+
+void game_reset(GameState *game) {
+    game->lives = START_LIVES;
+    game->sequence_length = 1;
+    game->player_steps = 0;
+    game->rounds = 0;
+    game->difficulty_level = 1;
+    game->game_over = false;
+    memset(game->sequence, 0, MAX_SEQUENCE);
+    memset(game->player_sequence, 0, MAX_SEQUENCE);
+}
+
+void game_generate_sequence(GameState *game, uint32_t seed) {
+    memset(game->sequence, 0, MAX_SEQUENCE);
+    memset(game->player_sequence, 0, MAX_SEQUENCE);
+    game->rng_state = seed ? seed : 0x9E3779B9;
+    if (game->sequence_length > MAX_SEQUENCE) game->sequence_length = MAX_SEQUENCE;
+    for (uint8_t i = 0; i < game->sequence_length; i++) {
+        game->sequence[i] = next_random(game) % 4; // 0 a 3 para direções diferentes
+    }
+    game->player_steps = 0;
+}
+
+// Retorna false se a entrada não cabe mais na rodada
+bool game_record_input(GameState *game, uint8_t direction) {
+    if (game->player_steps >= game->sequence_length || game->player_steps >= MAX_SEQUENCE)
+        return false;
+    game->player_sequence[game->player_steps++] = direction;
+    return true;
+}
+
+bool game_input_complete(const GameState *game) {
+    return game->player_steps >= game->sequence_length;
+}
+
+bool game_input_timed_out(const GameState *game, uint32_t elapsed_ms) {
+    return elapsed_ms > game_time_limit_ms(game);
+}
+
+game_verdict_t game_finish_round(GameState *game, bool timed_out) {
+    game_verdict_t verdict = GAME_VERDICT_SUCCESS;
+    if (timed_out) {
+        verdict = GAME_VERDICT_TIMEOUT;
+    } else {
+        for (uint8_t i = 0; i < game->sequence_length; i++) {
+            if (game->player_sequence[i] != game->sequence[i]) {
+                verdict = GAME_VERDICT_WRONG;
+                break;
+            }
+        }
+    }
+    if (verdict != GAME_VERDICT_SUCCESS && game->lives > 0) game->lives--;
+    game->game_over = (game->lives == 0);
+    return verdict;
+}
+
+// Próxima rodada; o nível satura em MAX_LEVEL e a sequência em MAX_SEQUENCE
+void game_advance(GameState *game) {
+    game->rounds++;
+    uint32_t level = (game->rounds / ROUNDS_PER_LEVEL) + 1;
+    game->difficulty_level = level > MAX_LEVEL ? MAX_LEVEL : (uint8_t)level;
+    game->sequence_length = game->difficulty_level;
+    if (game->sequence_length > MAX_SEQUENCE) {
+        game->sequence_length = MAX_SEQUENCE;
+    }
+}
+
+uint32_t game_time_limit_ms(const GameState *game) {
+    return decay(BASE_TIME_LIMIT_MS, TIME_DECREMENT_MS, game->difficulty_level, MIN_TIME_LIMIT_MS);
+}
+
+uint32_t game_arrow_display_ms(const GameState *game) {
+    return decay(BASE_ARROW_DISPLAY_MS, ARROW_DECREMENT_MS, game->difficulty_level, MIN_ARROW_DISPLAY_MS);
+}
+
+uint32_t game_reaction_ms(const GameState *game) {
+    return decay(BASE_REACTION_MS, REACTION_DECREMENT_MS, game->difficulty_level, MIN_REACTION_MS);
+}
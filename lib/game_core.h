@@ -0,0 +1,57 @@
+#ifndef GAME_CORE_H
+#define GAME_CORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Regras do jogo sem dependência de hardware: estado, sequência, vidas,
+// progressão de nível e tempos. O firmware cuida de E/S e relógio; o
+// simulador em tools/game_sim.c roda o mesmo código no host.
+
+#define MAX_SEQUENCE 20
+#define START_LIVES 3
+#define BASE_TIME_LIMIT_MS 10000 // 10s inicial
+#define TIME_DECREMENT_MS 200 // Decremento por nível
+#define MIN_TIME_LIMIT_MS 6000 // 6s mínimo
+#define ROUNDS_PER_LEVEL 5
+#define MAX_LEVEL 255
+#define BASE_REACTION_MS 3500
+#define REACTION_DECREMENT_MS 100
+#define MIN_REACTION_MS 2000
+#define BASE_ARROW_DISPLAY_MS 2000
+#define ARROW_DECREMENT_MS 50
+#define MIN_ARROW_DISPLAY_MS 500
+
+// Estrutura do estado do jogo
+typedef struct {
+    uint8_t lives;
+    uint8_t sequence[MAX_SEQUENCE];
+    uint8_t player_sequence[MAX_SEQUENCE];
+    uint8_t sequence_length;
+    uint8_t player_steps;
+    uint32_t rounds;
+    uint8_t difficulty_level;
+    bool game_over;
+    uint32_t rng_state;
+} GameState;
+
+// Mesmos valores de telemetry_result_t
+typedef enum {
+    GAME_VERDICT_SUCCESS = 0,
+    GAME_VERDICT_WRONG = 1,
+    GAME_VERDICT_TIMEOUT = 2
+} game_verdict_t;
+
+void game_reset(GameState *game);
+void game_generate_sequence(GameState *game, uint32_t seed);
+bool game_record_input(GameState *game, uint8_t direction);
+bool game_input_complete(const GameState *game);
+bool game_input_timed_out(const GameState *game, uint32_t elapsed_ms);
+game_verdict_t game_finish_round(GameState *game, bool timed_out);
+void game_advance(GameState *game);
+
+uint32_t game_time_limit_ms(const GameState *game);
+uint32_t game_arrow_display_ms(const GameState *game);
+uint32_t game_reaction_ms(const GameState *game);
+
+#endif
@@ -0,0 +1,148 @@
+#include "joystick.h"
+
+#define JOY_MIN_SPAN 256 // Limita a escala caso a calibração seja absurda
+
+static inline uint16_t median3(uint16_t a, uint16_t b, uint16_t c) {
+  if (a > b) { uint16_t t = a; a = b; b = t; }
+  if (b > c) b = c;
+  return a > b ? a : b;
+}
+
+static inline int32_t iabs(int32_t v) {
+  return v < 0 ? -v : v;
+}
+
+static inline uint32_t span_scale(int32_t span) {
+  if (span < JOY_MIN_SPAN) span = JOY_MIN_SPAN;
+  return ((uint32_t)JOY_FULL_SCALE << 16) / (uint32_t)span;
+}
+
+static void update_scales(joystick_t *js) {
+  js->scale_x_neg = span_scale((int32_t)js->center_x - js->min_x);
+  js->scale_x_pos = span_scale((int32_t)js->max_x - js->center_x);
+  js->scale_y_neg = span_scale((int32_t)js->center_y - js->min_y);
+  js->scale_y_pos = span_scale((int32_t)js->max_y - js->center_y);
+}
+
+static int16_t normalize(uint16_t v, uint16_t center, uint32_t scale_neg, uint32_t scale_pos) {
+  int32_t n;
+  if (v >= center)
+    n = (int32_t)(((uint32_t)(v - center) * scale_pos) >> 16);
+  else
+    n = -(int32_t)(((uint32_t)(center - v) * scale_neg) >> 16);
+  if (n > JOY_FULL_SCALE) n = JOY_FULL_SCALE;
+  if (n < -JOY_FULL_SCALE) n = -JOY_FULL_SCALE;
+  return (int16_t)n;
+}
+
+static inline bool is_x_axis(joy_direction_t dir) {
+  return dir == JOY_DIR_UP || dir == JOY_DIR_DOWN;
+}
+
+// Componente da deflexão no sentido da direção (negativa se oposta)
+static inline int32_t component(const joystick_t *js, joy_direction_t dir) {
+  switch (dir) {
+    case JOY_DIR_UP: return -js->norm_x;
+    case JOY_DIR_DOWN: return js->norm_x;
+    case JOY_DIR_LEFT: return -js->norm_y;
+    case JOY_DIR_RIGHT: return js->norm_y;
+    default: return 0;
+  }
+}
+
+void joystick_init(joystick_t *js) {
+  joystick_calibrate(js, (JOY_ADC_MAX + 1) / 2, (JOY_ADC_MAX + 1) / 2);
+}
+
+void joystick_calibrate(joystick_t *js, uint16_t center_x, uint16_t center_y) {
+  js->center_x = center_x;
+  js->center_y = center_y;
+  // Faixa mínima assumida; expande conforme os extremos reais aparecem
+  js->min_x = JOY_RANGE_MARGIN;
+  js->max_x = JOY_ADC_MAX - JOY_RANGE_MARGIN;
+  js->min_y = JOY_RANGE_MARGIN;
+  js->max_y = JOY_ADC_MAX - JOY_RANGE_MARGIN;
+  if (js->min_x > center_x) js->min_x = center_x;
+  if (js->max_x < center_x) js->max_x = center_x;
+  if (js->min_y > center_y) js->min_y = center_y;
+  if (js->max_y < center_y) js->max_y = center_y;
+  update_scales(js);
+
+  for (uint8_t i = 0; i < 3; i++) {
+    js->hist_x[i] = center_x;
+    js->hist_y[i] = center_y;
+  }
+  js->hist_pos = 0;
+  js->iir_x = (int32_t)center_x << JOY_IIR_FRAC;
+  js->iir_y = (int32_t)center_y << JOY_IIR_FRAC;
+  js->filt_x = center_x;
+  js->filt_y = center_y;
+  js->norm_x = 0;
+  js->norm_y = 0;
+  js->direction = JOY_DIR_NONE;
+  js->confidence = 255;
+}
+
+joy_direction_t joystick_update(joystick_t *js, uint16_t raw_x, uint16_t raw_y) {
+  // Mediana de 3 elimina picos isolados do ADC
+  js->hist_x[js->hist_pos] = raw_x;
+  js->hist_y[js->hist_pos] = raw_y;
+  js->hist_pos = (js->hist_pos == 2) ? 0 : js->hist_pos + 1;
+  uint16_t med_x = median3(js->hist_x[0], js->hist_x[1], js->hist_x[2]);
+  uint16_t med_y = median3(js->hist_y[0], js->hist_y[1], js->hist_y[2]);
+
+  // Passa-baixa de primeira ordem
+  js->iir_x += (((int32_t)med_x << JOY_IIR_FRAC) - js->iir_x) >> JOY_IIR_SHIFT;
+  js->iir_y += (((int32_t)med_y << JOY_IIR_FRAC) - js->iir_y) >> JOY_IIR_SHIFT;
+  js->filt_x = (uint16_t)(js->iir_x >> JOY_IIR_FRAC);
+  js->filt_y = (uint16_t)(js->iir_y >> JOY_IIR_FRAC);
+
+  // Expande a faixa calibrada quando o manche passa dos extremos conhecidos
+  bool range_changed = false;
+  if (js->filt_x < js->min_x) { js->min_x = js->filt_x; range_changed = true; }
+  if (js->filt_x > js->max_x) { js->max_x = js->filt_x; range_changed = true; }
+  if (js->filt_y < js->min_y) { js->min_y = js->filt_y; range_changed = true; }
+  if (js->filt_y > js->max_y) { js->max_y = js->filt_y; range_changed = true; }
+  if (range_changed) update_scales(js);
+
+  js->norm_x = normalize(js->filt_x, js->center_x, js->scale_x_neg, js->scale_x_pos);
+  js->norm_y = normalize(js->filt_y, js->center_y, js->scale_y_neg, js->scale_y_pos);
+
+  int32_t ax = iabs(js->norm_x);
+  int32_t ay = iabs(js->norm_y);
+  int32_t hi = ax > ay ? ax : ay;
+  int32_t lo = ax > ay ? ay : ax;
+  int32_t radius = hi + ((3 * lo) >> 3); // Aproximação de sqrt(x² + y²)
+
+  // Zona morta radial com histerese
+  int32_t threshold = (js->direction == JOY_DIR_NONE) ? JOY_DEADZONE_ENTER : JOY_DEADZONE_EXIT;
+  if (radius < threshold) {
+    js->direction = JOY_DIR_NONE;
+    js->confidence = (uint8_t)(((threshold - radius) * 255) / threshold);
+    return js->direction;
+  }
+
+  joy_direction_t candidate;
+  if (ax >= ay)
+    candidate = js->norm_x > 0 ? JOY_DIR_DOWN : JOY_DIR_UP;
+  else
+    candidate = js->norm_y > 0 ? JOY_DIR_RIGHT : JOY_DIR_LEFT;
+
+  // Histerese angular: perto da diagonal mantém a direção atual
+  joy_direction_t current = js->direction;
+  if (current != JOY_DIR_NONE && candidate != current && is_x_axis(current) != is_x_axis(candidate)) {
+    int32_t along = component(js, current);
+    if (along > 0 && hi * 256 < along * JOY_SWITCH_RATIO)
+      candidate = current;
+  }
+  js->direction = candidate;
+
+  // Confiança: profundidade além da zona morta x pureza do eixo
+  int32_t along = component(js, candidate);
+  int32_t across = is_x_axis(candidate) ? ay : ax;
+  int32_t radial = ((radius - JOY_DEADZONE_EXIT) * 255) / (JOY_FULL_SCALE - JOY_DEADZONE_EXIT);
+  int32_t purity = (along > across) ? ((along - across) * 255) / along : 0;
+  if (radial > 255) radial = 255;
+  js->confidence = (uint8_t)((radial * purity) >> 8);
+  return js->direction;
+}
@@ -0,0 +1,55 @@
+#ifndef JOYSTICK_H
+#define JOYSTICK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Pipeline de entrada do joystick em ponto fixo, sem dependência de hardware.
+//
+// amostra ADC -> mediana de 3 -> IIR -> centro/faixa calibrados -> zona morta
+// radial com histerese -> direção pelo eixo dominante com histerese angular.
+//
+// Eixos como no jogo: x alto = baixo, x baixo = cima, y baixo = esquerda,
+// y alto = direita.
+
+#define JOY_ADC_MAX 4095
+#define JOY_FULL_SCALE 1024       // Deflexão máxima normalizada
+#define JOY_IIR_SHIFT 2           // alpha = 1/4
+#define JOY_IIR_FRAC 4            // Bits fracionários do acumulador IIR
+#define JOY_DEADZONE_ENTER 560    // Raio para sair do centro (~55%)
+#define JOY_DEADZONE_EXIT 420     // Raio para voltar ao centro (~41%)
+#define JOY_SWITCH_RATIO 366      // tan(55°) * 256: troca de eixo só a 10° além da diagonal
+#define JOY_RANGE_MARGIN 300      // Faixa inicial assumida antes de observar os extremos
+
+// Valores iguais aos índices de arrow_frames
+typedef enum {
+    JOY_DIR_UP = 0,
+    JOY_DIR_DOWN = 1,
+    JOY_DIR_LEFT = 2,
+    JOY_DIR_RIGHT = 3,
+    JOY_DIR_NONE = 0xFF
+} joy_direction_t;
+
+typedef struct {
+    // Calibração
+    uint16_t center_x, center_y;
+    uint16_t min_x, max_x, min_y, max_y;
+    uint32_t scale_x_neg, scale_x_pos, scale_y_neg, scale_y_pos; // Q16
+
+    // Estado dos filtros
+    uint16_t hist_x[3], hist_y[3];
+    uint8_t hist_pos;
+    int32_t iir_x, iir_y;
+
+    // Saídas
+    uint16_t filt_x, filt_y;      // Leitura filtrada na escala do ADC
+    int16_t norm_x, norm_y;       // -JOY_FULL_SCALE..JOY_FULL_SCALE
+    joy_direction_t direction;
+    uint8_t confidence;           // 0..255
+} joystick_t;
+
+void joystick_init(joystick_t *js);
+void joystick_calibrate(joystick_t *js, uint16_t center_x, uint16_t center_y);
+joy_direction_t joystick_update(joystick_t *js, uint16_t raw_x, uint16_t raw_y);
+
+#endif
@@ -0,0 +1,103 @@
+#include <string.h>
+#include "led_matrix.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "pio_matrix.pio.h"
+
+#define MATRIX_LEDS_PER_LANE (MATRIX_NUM_LEDS / MATRIX_LANES)
+
+#if MATRIX_LANES > 1
+// Transposto: uma palavra por bit de cada LED, um bit por faixa
+#define MATRIX_TX_WORDS (MATRIX_LEDS_PER_LANE * MATRIX_BITS_PER_LED)
+#define MATRIX_CYCLES_PER_BIT pio_matrix_parallel_CYCLES_PER_BIT
+#else
+#define MATRIX_TX_WORDS MATRIX_NUM_LEDS
+#define MATRIX_CYCLES_PER_BIT pio_matrix_CYCLES_PER_BIT
+#endif
+
+_Static_assert(MATRIX_WIDTH >= MATRIX_SPRITE_SIZE && MATRIX_HEIGHT >= MATRIX_SPRITE_SIZE,
+               "painel menor que o quadro 5x5");
+_Static_assert(MATRIX_LANES >= 1 && MATRIX_LANES <= 32, "de 1 a 32 faixas");
+_Static_assert(MATRIX_NUM_LEDS % MATRIX_LANES == 0, "LEDs não dividem igualmente entre as faixas");
+_Static_assert(MATRIX_REFRESH_US <= MATRIX_FRAME_BUDGET_US, "painel lento demais; aumente MATRIX_LANES");
+
+static PIO matrix_pio;
+static uint matrix_sm;
+static uint matrix_dma;
+static uint32_t tx_words[MATRIX_TX_WORDS]; // Lido pelo DMA enquanto a transferência corre
+static uint16_t sprite_map[MATRIX_SPRITE_LEDS]; // LED do painel de cada pixel do quadro
+
+// Posição no fio do LED na linha/coluna do painel
+static uint16_t panel_index(uint16_t row, uint16_t col) {
+    if (MATRIX_SERPENTINE && (row & 1)) col = MATRIX_WIDTH - 1 - col;
+    return row * MATRIX_WIDTH + col;
+}
+
+static inline void put_pixel(uint16_t led, uint32_t color) {
+#if MATRIX_LANES > 1
+    uint32_t lane_bit = 1u << (led / MATRIX_LEDS_PER_LANE);
+    uint32_t *plane = &tx_words[(led % MATRIX_LEDS_PER_LANE) * MATRIX_BITS_PER_LED];
+    for (uint b = 0; b < MATRIX_BITS_PER_LED; b++) {
+        if (color & (0x80000000u >> b))
+            plane[b] |= lane_bit;
+        else
+            plane[b] &= ~lane_bit;
+    }
+#else
+    tx_words[led] = color;
+#endif
+}
+
+void led_matrix_init(PIO pio, uint pin) {
+    matrix_pio = pio;
+    matrix_sm = pio_claim_unused_sm(pio, true);
+#if MATRIX_LANES > 1
+    uint offset = pio_add_program(pio, &pio_matrix_parallel_program);
+    pio_matrix_parallel_program_init(pio, matrix_sm, offset, pin, MATRIX_LANES, MATRIX_BIT_HZ);
+#else
+    uint offset = pio_add_program(pio, &pio_matrix_program);
+    pio_matrix_program_init(pio, matrix_sm, offset, pin, MATRIX_BITS_PER_LED, MATRIX_BIT_HZ);
+#endif
+    pio_sm_set_enabled(pio, matrix_sm, true);
+
+    // Quadro 5x5 centralizado; fora dele o painel fica apagado
+    uint16_t top = (MATRIX_HEIGHT - MATRIX_SPRITE_SIZE) / 2;
+    uint16_t left = (MATRIX_WIDTH - MATRIX_SPRITE_SIZE) / 2;
+    for (uint16_t row = 0; row < MATRIX_SPRITE_SIZE; row++) {
+        for (uint16_t col = 0; col < MATRIX_SPRITE_SIZE; col++) {
+            sprite_map[row * MATRIX_SPRITE_SIZE + col] = panel_index(top + row, left + col);
+        }
+    }
+    memset(tx_words, 0, sizeof(tx_words));
+
+    matrix_dma = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(matrix_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, matrix_sm, true));
+    dma_channel_configure(matrix_dma, &c, &pio->txf[matrix_sm], tx_words, MATRIX_TX_WORDS, false);
+}
+
+bool led_matrix_busy() {
+    return dma_channel_is_busy(matrix_dma);
+}
+
+void led_matrix_wait() {
+    dma_channel_wait_for_finish_blocking(matrix_dma);
+}
+
+// Recalcula o divisor do PIO depois de mudar o clk_sys
+void led_matrix_retime() {
+    led_matrix_wait();
+    pio_sm_set_clkdiv(matrix_pio, matrix_sm, pio_matrix_clkdiv(MATRIX_BIT_HZ, MATRIX_CYCLES_PER_BIT));
+}
+
+// Copia o quadro para o buffer do painel e dispara o DMA. Só espera se o
+// frame anterior ainda estiver saindo (~0,75 ms para 25 LEDs, MATRIX_REFRESH_US
+// no geral). Só as posições do quadro 5x5 são reescritas.
+void __not_in_flash_func(led_matrix_show)(const matrix_frame_t *frame) {
+    dma_channel_wait_for_finish_blocking(matrix_dma);
+    for (uint i = 0; i < MATRIX_SPRITE_LEDS; i++) put_pixel(sprite_map[i], frame->pixels[i]);
+    dma_channel_transfer_from_buffer_now(matrix_dma, tx_words, MATRIX_TX_WORDS);
+}
@@ -0,0 +1,54 @@
+#ifndef LED_MATRIX_H
+#define LED_MATRIX_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Matriz WS2812 alimentada por DMA: led_matrix_show() não espera os bits
+// saírem, então pode ser chamada de callbacks de alarme.
+//
+// O painel é configurado no CMake (MATRIX_WIDTH, MATRIX_HEIGHT, MATRIX_RGBW,
+// MATRIX_LANES, MATRIX_SERPENTINE). O jogo desenha quadros 5x5, que ficam
+// centralizados em painéis maiores. Com MATRIX_LANES > 1 o painel é dividido
+// em faixas iguais, cada uma em um pino a partir do pino base.
+
+#ifndef MATRIX_WIDTH
+#define MATRIX_WIDTH 5
+#endif
+#ifndef MATRIX_HEIGHT
+#define MATRIX_HEIGHT 5
+#endif
+#ifndef MATRIX_RGBW
+#define MATRIX_RGBW 0 // 1 para SK6812 RGBW
+#endif
+#ifndef MATRIX_LANES
+#define MATRIX_LANES 1
+#endif
+#ifndef MATRIX_SERPENTINE
+#define MATRIX_SERPENTINE 0 // Linhas ímpares ligadas da direita para a esquerda
+#endif
+
+#define MATRIX_BIT_HZ 800000
+#define MATRIX_BITS_PER_LED (MATRIX_RGBW ? 32 : 24)
+#define MATRIX_NUM_LEDS (MATRIX_WIDTH * MATRIX_HEIGHT)
+#define MATRIX_SPRITE_SIZE 5
+#define MATRIX_SPRITE_LEDS (MATRIX_SPRITE_SIZE * MATRIX_SPRITE_SIZE)
+
+// Tempo para enviar o painel inteiro; precisa caber em um ciclo de entrada
+// (sleep_ms(10) em player_input)
+#define MATRIX_RESET_US 80
+#define MATRIX_REFRESH_US \
+    ((MATRIX_NUM_LEDS / MATRIX_LANES) * MATRIX_BITS_PER_LED * 1000000ull / MATRIX_BIT_HZ + MATRIX_RESET_US)
+#define MATRIX_FRAME_BUDGET_US 10000
+
+typedef struct {
+    uint32_t pixels[MATRIX_SPRITE_LEDS]; // GRB nos 24 bits superiores, W no byte baixo
+} matrix_frame_t;
+
+void led_matrix_init(PIO pio, uint pin);
+void led_matrix_show(const matrix_frame_t *frame);
+bool led_matrix_busy();
+void led_matrix_wait();
+void led_matrix_retime();
+
+#endif
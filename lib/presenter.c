@@ -0,0 +1,55 @@
+#include "presenter.h"
+
+static int64_t __not_in_flash_func(presenter_alarm)(alarm_id_t id, void *user_data) {
+    presenter_t *p = (presenter_t *)user_data;
+    uint8_t step = p->next;
+    led_matrix_show(p->steps[step].frame);
+    p->actual_us[step] = (uint32_t)(time_us_64() - p->start_us);
+    p->next = step + 1;
+    if (p->next >= p->count) return 0;
+    // Negativo: relativo ao horário em que este alarme deveria disparar
+    return -(int64_t)(p->steps[step + 1].at_us - p->steps[step].at_us);
+}
+
+void presenter_clear(presenter_t *p) {
+    p->count = 0;
+    p->next = 0;
+}
+
+// Passos devem ser adicionados em ordem estritamente crescente de tempo: um
+// intervalo zero faria o alarme retornar 0 e parar antes do fim
+bool presenter_add(presenter_t *p, uint32_t at_us, const matrix_frame_t *frame) {
+    if (p->count >= PRESENTER_MAX_STEPS) return false;
+    if (p->count > 0 && at_us <= p->steps[p->count - 1].at_us) return false;
+    p->steps[p->count].at_us = at_us;
+    p->steps[p->count].frame = frame;
+    p->count++;
+    return true;
+}
+
+// O primeiro passo acontece lead_us depois da chamada mais o seu at_us
+bool presenter_start(presenter_t *p, uint32_t lead_us) {
+    p->next = 0;
+    if (p->count == 0) return false;
+    p->start_us = time_us_64() + lead_us;
+    absolute_time_t first = from_us_since_boot(p->start_us + p->steps[0].at_us);
+    return add_alarm_at(first, presenter_alarm, p, true) >= 0;
+}
+
+// Sem alarme livre: os mesmos passos nos mesmos horários, esperando aqui
+void presenter_run_blocking(presenter_t *p) {
+    for (uint8_t step = p->next; step < p->count; step++) {
+        sleep_until(from_us_since_boot(p->start_us + p->steps[step].at_us));
+        led_matrix_show(p->steps[step].frame);
+        p->actual_us[step] = (uint32_t)(time_us_64() - p->start_us);
+        p->next = step + 1;
+    }
+}
+
+bool presenter_done(const presenter_t *p) {
+    return p->next >= p->count;
+}
+
+int32_t presenter_jitter_us(const presenter_t *p, uint8_t step) {
+    return (int32_t)(p->actual_us[step] - p->steps[step].at_us);
+}
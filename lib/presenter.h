@@ -0,0 +1,37 @@
+#ifndef PRESENTER_H
+#define PRESENTER_H
+
+#include "pico/stdlib.h"
+#include "led_matrix.h"
+
+// Apresentação de sequências com horário absoluto.
+//
+// A linha do tempo da rodada (frame + instante relativo ao início) é
+// montada antes de começar, com todos os frames já renderizados. Um alarme
+// de hardware dispara cada commit na matriz e se reagenda a partir do
+// horário previsto, não do horário em que rodou, então o atraso de um passo
+// não se acumula nos seguintes.
+
+#define PRESENTER_MAX_STEPS 48
+
+typedef struct {
+    uint32_t at_us; // Relativo ao início da apresentação
+    const matrix_frame_t *frame;
+} presenter_step_t;
+
+typedef struct {
+    presenter_step_t steps[PRESENTER_MAX_STEPS];
+    uint32_t actual_us[PRESENTER_MAX_STEPS]; // Instante real de cada commit
+    uint8_t count;
+    volatile uint8_t next;
+    uint64_t start_us;
+} presenter_t;
+
+void presenter_clear(presenter_t *p);
+bool presenter_add(presenter_t *p, uint32_t at_us, const matrix_frame_t *frame);
+bool presenter_start(presenter_t *p, uint32_t lead_us);
+void presenter_run_blocking(presenter_t *p);
+bool presenter_done(const presenter_t *p);
+int32_t presenter_jitter_us(const presenter_t *p, uint8_t step);
+
+#endif
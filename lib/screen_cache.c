@@ -0,0 +1,135 @@
+#include <string.h>
+#include "screen_cache.h"
+
+// Página comprimida: sequência de blocos até completar WIDTH bytes.
+//   0x80 | (n - 1), v       -> n cópias de v (3..128)
+//   n - 1, b0 .. b(n-1)     -> n bytes literais (1..128)
+#define RLE_RUN 0x80
+#define RLE_MAX 128
+
+static uint8_t pool[SCREEN_CACHE_POOL_SIZE];
+static size_t pool_used = 0;
+
+static inline uint8_t *page_of(ssd1306_t *ssd, uint8_t page) {
+  return &ssd->ram_buffer[page * WIDTH + 1];
+}
+
+static inline size_t run_length(const uint8_t *src, size_t pos, size_t len) {
+  size_t run = 1;
+  while (pos + run < len && run < RLE_MAX && src[pos + run] == src[pos])
+    run++;
+  return run;
+}
+
+// Retorna o tamanho comprimido ou 0 se não couber em dst
+static size_t rle_encode(const uint8_t *src, size_t len, uint8_t *dst, size_t room) {
+  size_t out = 0;
+  size_t i = 0;
+  while (i < len) {
+    size_t run = run_length(src, i, len);
+    if (run >= 3) {
+      if (out + 2 > room) return 0;
+      dst[out++] = RLE_RUN | (uint8_t)(run - 1);
+      dst[out++] = src[i];
+      i += run;
+      continue;
+    }
+    size_t start = i;
+    while (i < len && i - start < RLE_MAX && run_length(src, i, len) < 3)
+      i++;
+    size_t count = i - start;
+    if (out + 1 + count > room) return 0;
+    dst[out++] = (uint8_t)(count - 1);
+    memcpy(&dst[out], &src[start], count);
+    out += count;
+  }
+  return out;
+}
+
+static void rle_decode(const uint8_t *src, uint8_t *dst, size_t len) {
+  size_t out = 0;
+  while (out < len) {
+    uint8_t ctrl = *src++;
+    size_t count = (ctrl & (RLE_RUN - 1)) + 1;
+    if (ctrl & RLE_RUN) {
+      memset(&dst[out], *src++, count);
+    } else {
+      memcpy(&dst[out], src, count);
+      src += count;
+    }
+    out += count;
+  }
+}
+
+void screen_cache_reset() {
+  pool_used = 0;
+}
+
+bool screen_cache_capture(screen_t *screen, const ssd1306_t *ssd, bool compress) {
+  size_t start = pool_used;
+  screen->valid = false;
+  screen->compressed = compress;
+  for (uint8_t page = 0; page < DISPLAY_PAGES; ++page) {
+    const uint8_t *src = &ssd->ram_buffer[page * WIDTH + 1];
+    size_t room = SCREEN_CACHE_POOL_SIZE - pool_used;
+    size_t size;
+    if (compress) {
+      size = rle_encode(src, WIDTH, &pool[pool_used], room);
+    } else {
+      size = (room >= WIDTH) ? WIDTH : 0;
+      if (size) memcpy(&pool[pool_used], src, WIDTH);
+    }
+    if (size == 0) {
+      pool_used = start; // Sem espaço: desfaz a captura parcial
+      return false;
+    }
+    screen->page_offset[page] = (uint16_t)pool_used;
+    pool_used += size;
+  }
+  screen->valid = true;
+  return true;
+}
+
+uint8_t screen_cache_add_slot(screen_t *screen, int16_t x, int16_t y, uint8_t chars) {
+  if (screen->slot_count >= SCREEN_MAX_SLOTS) return 0xFF;
+  screen_slot_t *slot = &screen->slots[screen->slot_count];
+  slot->x = x;
+  slot->y = y;
+  slot->chars = chars;
+  return screen->slot_count++;
+}
+
+void screen_cache_load(const screen_t *screen, ssd1306_t *ssd) {
+  if (!screen->compressed) {
+    // Páginas consecutivas no pool: uma única cópia
+    memcpy(page_of(ssd, 0), &pool[screen->page_offset[0]], WIDTH * DISPLAY_PAGES);
+    return;
+  }
+  for (uint8_t page = 0; page < DISPLAY_PAGES; ++page)
+    rle_decode(&pool[screen->page_offset[page]], page_of(ssd, page), WIDTH);
+}
+
+// Escreve o número alinhado à esquerda no slot; sobra vira espaço e
+// valores que não cabem saturam em 9...9
+void screen_cache_patch_number(const screen_t *screen, ssd1306_t *ssd, uint8_t slot, uint32_t value) {
+  if (slot >= screen->slot_count) return;
+  const screen_slot_t *s = &screen->slots[slot];
+  char digits[11];
+  uint8_t len = 0;
+  do {
+    digits[len++] = '0' + (value % 10);
+    value /= 10;
+  } while (value && len < sizeof(digits));
+  if (len > s->chars) {
+    len = s->chars;
+    memset(digits, '9', len);
+  }
+  for (uint8_t i = 0; i < s->chars; ++i) {
+    char c = (i < len) ? digits[len - 1 - i] : ' ';
+    ssd1306_draw_char(ssd, c, s->x + i * 8, s->y);
+  }
+}
+
+size_t screen_cache_used() {
+  return pool_used;
+}
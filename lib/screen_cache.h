@@ -0,0 +1,37 @@
+#ifndef SCREEN_CACHE_H
+#define SCREEN_CACHE_H
+
+#include "ssd1306.h"
+
+// Cache de telas pré-renderizadas.
+//
+// Uma tela é desenhada uma única vez no buffer do display e capturada:
+// telas estáticas guardam o buffer inteiro; modelos com campos variáveis
+// guardam cada página comprimida em RLE e declaram slots de caracteres
+// onde números são escritos na hora de exibir. Exibir custa uma cópia ou
+// descompressão e o envio ao display, sem redesenhar texto.
+
+#define SCREEN_CACHE_POOL_SIZE 2048
+#define SCREEN_MAX_SLOTS 2
+
+typedef struct {
+  int16_t x, y;   // y múltiplo de 8 deixa o patch em cópia direta
+  uint8_t chars;  // Largura do campo em caracteres
+} screen_slot_t;
+
+typedef struct {
+  bool valid;
+  bool compressed;
+  uint16_t page_offset[DISPLAY_PAGES]; // Início de cada página no pool
+  uint8_t slot_count;
+  screen_slot_t slots[SCREEN_MAX_SLOTS];
+} screen_t;
+
+void screen_cache_reset();
+bool screen_cache_capture(screen_t *screen, const ssd1306_t *ssd, bool compress);
+uint8_t screen_cache_add_slot(screen_t *screen, int16_t x, int16_t y, uint8_t chars);
+void screen_cache_load(const screen_t *screen, ssd1306_t *ssd);
+void screen_cache_patch_number(const screen_t *screen, ssd1306_t *ssd, uint8_t slot, uint32_t value);
+size_t screen_cache_used();
+
+#endif
@@ -1,22 +1,86 @@
+#include <string.h>
 #include "ssd1306.h"
 #include "font.h"
+#include "hardware/dma.h"
+
+// O quadro inteiro sai numa só transferência de DMA: cada palavra de 16 bits
+// vai para o IC_DATA_CMD do I2C, com RESTART entre comandos e dados e STOP
+// na última. Os cabeçalhos são montados uma vez; o envio só copia os pixels.
+#if DISPLAY_SH1106
+#define FLUSH_HEADER_WORDS 5 // 0x00, página, coluna baixa, coluna alta, 0x40
+#define FLUSH_PAGE_WORDS (FLUSH_HEADER_WORDS + WIDTH)
+#define FLUSH_WORDS (DISPLAY_PAGES * FLUSH_PAGE_WORDS)
+#else
+#define FLUSH_HEADER_WORDS 8 // 0x00, COL_ADDR x3, PAGE_ADDR x3, 0x40
+#define FLUSH_WORDS (FLUSH_HEADER_WORDS + DISPLAY_BUFSIZE - 1)
+#endif
+
+static uint16_t flush_words[FLUSH_WORDS]; // Lido pelo DMA enquanto o envio corre
+static int flush_dma = -1;
+
+static void flush_init(ssd1306_t *ssd) {
+#if DISPLAY_SH1106
+  for (uint8_t page = 0; page < DISPLAY_PAGES; ++page) {
+    uint16_t *w = &flush_words[page * FLUSH_PAGE_WORDS];
+    w[0] = 0x00 | (page ? I2C_IC_DATA_CMD_RESTART_BITS : 0);
+    w[1] = SH1106_SET_PAGE | page;
+    w[2] = SH1106_SET_COL_LOW | (DISPLAY_COL_OFFSET & 0x0F);
+    w[3] = SH1106_SET_COL_HIGH | (DISPLAY_COL_OFFSET >> 4);
+    w[4] = 0x40 | I2C_IC_DATA_CMD_RESTART_BITS;
+  }
+#else
+  static const uint8_t header[FLUSH_HEADER_WORDS - 1] = {
+    0x00, SET_COL_ADDR, DISPLAY_COL_OFFSET, DISPLAY_COL_OFFSET + WIDTH - 1,
+    SET_PAGE_ADDR, 0, DISPLAY_PAGES - 1
+  };
+  for (uint8_t i = 0; i < FLUSH_HEADER_WORDS - 1; ++i)
+    flush_words[i] = header[i];
+  flush_words[FLUSH_HEADER_WORDS - 1] = 0x40 | I2C_IC_DATA_CMD_RESTART_BITS;
+#endif
+
+  flush_dma = dma_claim_unused_channel(true);
+  dma_channel_config c = dma_channel_get_default_config(flush_dma);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, i2c_get_dreq(ssd->i2c_port, true));
+  dma_channel_configure(flush_dma, &c, &i2c_get_hw(ssd->i2c_port)->data_cmd, flush_words, FLUSH_WORDS, false);
+}
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
-  ssd->width = width;
-  ssd->height = height;
-  ssd->pages = height / 8U;
+  // A geometria é fixada por DISPLAY_PANEL em tempo de compilação
+  if (width != WIDTH || height != HEIGHT)
+    panic("ssd1306: painel %ux%u, compilado para %ux%u", width, height, WIDTH, HEIGHT);
+  ssd->width = WIDTH;
+  ssd->height = HEIGHT;
+  ssd->pages = DISPLAY_PAGES;
   ssd->address = address;
   ssd->i2c_port = i2c;
-  ssd->bufsize = ssd->pages * ssd->width + 1;
+  ssd->bufsize = DISPLAY_BUFSIZE;
   ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
   ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+  flush_init(ssd);
+}
+
+// O DMA termina quando a última palavra entra na FIFO; o envio só acaba
+// quando a FIFO esvazia e o STOP sai no barramento
+void ssd1306_wait(ssd1306_t *ssd) {
+  if (flush_dma < 0)
+    return;
+  dma_channel_wait_for_finish_blocking(flush_dma);
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  while (!(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS))
+    tight_loop_contents();
 }
 
 void ssd1306_config(ssd1306_t *ssd) {
   ssd1306_command(ssd, SET_DISP | 0x00);
+#if !DISPLAY_SH1106
+  // Endereçamento horizontal, igual à organização por página do buffer
   ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
+  ssd1306_command(ssd, 0x00);
+#endif
   ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
   ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
   ssd1306_command(ssd, SET_MUX_RATIO);
@@ -25,7 +89,7 @@ void ssd1306_config(ssd1306_t *ssd) {
   ssd1306_command(ssd, SET_DISP_OFFSET);
   ssd1306_command(ssd, 0x00);
   ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
+  ssd1306_command(ssd, DISPLAY_COM_PIN_CFG);
   ssd1306_command(ssd, SET_DISP_CLK_DIV);
   ssd1306_command(ssd, 0x80);
   ssd1306_command(ssd, SET_PRECHARGE);
@@ -36,12 +100,18 @@ void ssd1306_config(ssd1306_t *ssd) {
   ssd1306_command(ssd, 0xFF);
   ssd1306_command(ssd, SET_ENTIRE_ON);
   ssd1306_command(ssd, SET_NORM_INV);
+#if DISPLAY_SH1106
+  ssd1306_command(ssd, SH1106_SET_DCDC);
+  ssd1306_command(ssd, 0x8B);
+#else
   ssd1306_command(ssd, SET_CHARGE_PUMP);
   ssd1306_command(ssd, 0x14);
+#endif
   ssd1306_command(ssd, SET_DISP | 0x01);
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  ssd1306_wait(ssd);
   ssd->port_buffer[1] = command;
   i2c_write_blocking(
     ssd->i2c_port,
@@ -52,68 +122,58 @@ void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   );
 }
 
+// Copia o buffer para as palavras do DMA e dispara o envio sem bloquear.
+// Espera antes o envio anterior, então o buffer pode ser redesenhado logo
+// após a chamada.
 void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
-}
+  ssd1306_wait(ssd);
+#if DISPLAY_SH1106
+  // SH1106: só endereçamento por página, com o deslocamento de coluna do painel
+  for (uint8_t page = 0; page < DISPLAY_PAGES; ++page) {
+    uint16_t *w = &flush_words[page * FLUSH_PAGE_WORDS + FLUSH_HEADER_WORDS];
+    const uint8_t *src = &ssd->ram_buffer[page * WIDTH + 1];
+    for (uint8_t x = 0; x < WIDTH; ++x)
+      w[x] = src[x];
+  }
+#else
+  for (size_t i = 1; i < DISPLAY_BUFSIZE; ++i)
+    flush_words[FLUSH_HEADER_WORDS + i - 1] = ssd->ram_buffer[i];
+#endif
+  flush_words[FLUSH_WORDS - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
 
-void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
-  uint8_t pixel = (y & 0b111);
-  if (value)
-    ssd->ram_buffer[index] |= (1 << pixel);
-  else
-    ssd->ram_buffer[index] &= ~(1 << pixel);
+  // Mesmo preparo do i2c_write_blocking: endereço do painel e abortos limpos
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  hw->enable = 0;
+  hw->tar = ssd->address;
+  hw->enable = 1;
+  (void)hw->clr_tx_abrt;
+  dma_channel_transfer_from_buffer_now(flush_dma, flush_words, FLUSH_WORDS);
 }
 
-/*
 void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
-
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
-    }
+  memset(&ssd->ram_buffer[1], value ? 0xFF : 0x00, DISPLAY_BUFSIZE - 1);
 }
 
-
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
+void ssd1306_rect(ssd1306_t *ssd, int16_t top, int16_t left, int16_t width, int16_t height, bool value, bool fill) {
+  for (int16_t x = left; x < left + width; ++x) {
     ssd1306_pixel(ssd, x, top, value);
     ssd1306_pixel(ssd, x, top + height - 1, value);
   }
-  for (uint8_t y = top; y < top + height; ++y) {
+  for (int16_t y = top; y < top + height; ++y) {
     ssd1306_pixel(ssd, left, y, value);
     ssd1306_pixel(ssd, left + width - 1, y, value);
   }
 
   if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
+    for (int16_t x = left + 1; x < left + width - 1; ++x) {
+      for (int16_t y = top + 1; y < top + height - 1; ++y) {
         ssd1306_pixel(ssd, x, y, value);
       }
     }
   }
 }
 
-void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
+void ssd1306_line(ssd1306_t *ssd, int16_t x0, int16_t y0, int16_t x1, int16_t y1, bool value) {
     int dx = abs(x1 - x0);
     int dy = abs(y1 - y0);
 
@@ -142,18 +202,18 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 }
 
 
-void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
+void ssd1306_hline(ssd1306_t *ssd, int16_t x0, int16_t x1, int16_t y, bool value) {
+  for (int16_t x = x0; x <= x1; ++x)
     ssd1306_pixel(ssd, x, y, value);
 }
 
-void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
+void ssd1306_vline(ssd1306_t *ssd, int16_t x, int16_t y0, int16_t y1, bool value) {
+  for (int16_t y = y0; y <= y1; ++y)
     ssd1306_pixel(ssd, x, y, value);
 }
 
 // Função para desenhar um caractere
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+void ssd1306_draw_char(ssd1306_t *ssd, char c, int16_t x, int16_t y)
 {
   uint16_t index = 0;
   char ver=c;
@@ -166,7 +226,14 @@ void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
   }else if(c >= 'a' && c <= 'z'){
     index = (c - 'a' + 37) * 8; // Para letras minúsculas
   }
-  
+
+  // Célula alinhada à página e inteira no painel: cópia direta das colunas
+  if ((y & 0b111) == 0 && y >= 0 && y < HEIGHT && x >= 0 && x + 8 <= WIDTH)
+  {
+    memcpy(&ssd->ram_buffer[(y >> 3) * WIDTH + x + 1], &font[index], 8);
+    return;
+  }
+
   for (uint8_t i = 0; i < 8; ++i)
   {
     uint8_t line = font[index + i];
@@ -178,18 +245,19 @@ void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
 }
 
 // Função para desenhar uma string
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, int16_t x, int16_t y)
 {
   while (*str)
   {
     ssd1306_draw_char(ssd, *str++, x, y);
     x += 8;
-    if (x + 8 >= ssd->width)
+    // Quebra só quando o próximo caractere não cabe inteiro
+    if (x + 8 > ssd->width)
     {
       x = 0;
       y += 8;
     }
-    if (y + 8 >= ssd->height)
+    if (y + 8 > ssd->height)
     {
       break;
     }
@@ -1,9 +1,10 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
-
-#define WIDTH 128
-#define HEIGHT 64
+#include "display.h"
 
 typedef enum {
   SET_CONTRAST = 0x81,
@@ -22,7 +23,11 @@ typedef enum {
   SET_DISP_CLK_DIV = 0xD5,
   SET_PRECHARGE = 0xD9,
   SET_VCOM_DESEL = 0xDB,
-  SET_CHARGE_PUMP = 0x8D
+  SET_CHARGE_PUMP = 0x8D,
+  SH1106_SET_PAGE = 0xB0,
+  SH1106_SET_COL_LOW = 0x00,
+  SH1106_SET_COL_HIGH = 0x10,
+  SH1106_SET_DCDC = 0xAD
 } ssd1306_command_t;
 
 typedef struct {
@@ -37,13 +42,29 @@ typedef struct {
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+// Envio por DMA: retorna logo; ssd1306_wait() bloqueia até o quadro sair
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_wait(ssd1306_t *ssd);
+
+// Buffer organizado por página: byte (y / 8) * WIDTH + x, bit y % 8.
+// Coordenadas fora do painel são descartadas (clipping).
+static inline void ssd1306_pixel(ssd1306_t *ssd, int16_t x, int16_t y, bool value) {
+  if ((uint16_t)x >= WIDTH || (uint16_t)y >= HEIGHT)
+    return;
+  uint16_t index = (y >> 3) * WIDTH + x + 1;
+  uint8_t pixel = (y & 0b111);
+  if (value)
+    ssd->ram_buffer[index] |= (1 << pixel);
+  else
+    ssd->ram_buffer[index] &= ~(1 << pixel);
+}
 
-void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill);
-void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
-void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
-void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+void ssd1306_rect(ssd1306_t *ssd, int16_t top, int16_t left, int16_t width, int16_t height, bool value, bool fill);
+void ssd1306_line(ssd1306_t *ssd, int16_t x0, int16_t y0, int16_t x1, int16_t y1, bool value);
+void ssd1306_hline(ssd1306_t *ssd, int16_t x0, int16_t x1, int16_t y, bool value);
+void ssd1306_vline(ssd1306_t *ssd, int16_t x, int16_t y0, int16_t y1, bool value);
+void ssd1306_draw_char(ssd1306_t *ssd, char c, int16_t x, int16_t y);
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, int16_t x, int16_t y);
+
+#endif
@@ -0,0 +1,193 @@
+#include "telemetry.h"
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "pico/unique_id.h"
+#include "tusb.h"
+
+#define TELEMETRY_HEADER_SIZE 8
+#define TELEMETRY_RAW_MAX (TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_PAYLOAD + 1)
+#define TELEMETRY_FRAME_MAX (TELEMETRY_RAW_MAX + (TELEMETRY_RAW_MAX / 254) + 2)
+#define TELEMETRY_QUEUE_MASK (TELEMETRY_QUEUE_SIZE - 1)
+
+static uint8_t queue[TELEMETRY_QUEUE_SIZE];
+static uint16_t queue_head = 0; // Próxima escrita
+static uint16_t queue_tail = 0; // Próxima leitura
+static uint16_t frame_seq = 0;
+static uint32_t frames_dropped = 0;
+
+static uint8_t crc8(const uint8_t *data, size_t len) {
+    uint8_t crc = 0;
+    while (len--) {
+        crc ^= *data++;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// Codifica em COBS e acrescenta o delimitador 0x00. Retorna o tamanho final.
+static size_t cobs_encode(const uint8_t *src, size_t len, uint8_t *dst) {
+    size_t code_pos = 0;
+    size_t out = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < len; i++) {
+        if (src[i] == 0) {
+            dst[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+        } else {
+            dst[out++] = src[i];
+            if (++code == 0xFF) {
+                dst[code_pos] = code;
+                code_pos = out++;
+                code = 1;
+            }
+        }
+    }
+    dst[code_pos] = code;
+    dst[out++] = 0x00;
+    return out;
+}
+
+static inline void put_u16(uint8_t *p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static inline void put_u32(uint8_t *p, uint32_t v) {
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = v >> 24;
+}
+
+void telemetry_init() {
+    queue_head = 0;
+    queue_tail = 0;
+    frame_seq = 0;
+    frames_dropped = 0;
+}
+
+void telemetry_emit(telemetry_event_t type, const uint8_t *payload, size_t len) {
+    uint8_t raw[TELEMETRY_RAW_MAX];
+    uint8_t frame[TELEMETRY_FRAME_MAX];
+
+    if (len > TELEMETRY_MAX_PAYLOAD) len = TELEMETRY_MAX_PAYLOAD;
+    raw[0] = TELEMETRY_SCHEMA_VERSION;
+    raw[1] = (uint8_t)type;
+    put_u16(&raw[2], frame_seq++);
+    put_u32(&raw[4], time_us_32());
+    for (size_t i = 0; i < len; i++) raw[TELEMETRY_HEADER_SIZE + i] = payload[i];
+    size_t raw_len = TELEMETRY_HEADER_SIZE + len;
+    raw[raw_len] = crc8(raw, raw_len);
+    raw_len++;
+
+    size_t frame_len = cobs_encode(raw, raw_len, frame);
+    uint16_t used = (uint16_t)(queue_head - queue_tail) & TELEMETRY_QUEUE_MASK;
+    if (frame_len > (size_t)(TELEMETRY_QUEUE_MASK - used)) {
+        frames_dropped++;
+        return;
+    }
+    for (size_t i = 0; i < frame_len; i++) {
+        queue[queue_head] = frame[i];
+        queue_head = (queue_head + 1) & TELEMETRY_QUEUE_MASK;
+    }
+}
+
+void telemetry_task() {
+    if (!stdio_usb_connected()) return;
+    while (queue_tail != queue_head) {
+        uint32_t space = tud_cdc_write_available();
+        if (space == 0) return;
+        // Trecho contíguo até o fim do buffer circular
+        uint16_t chunk = (queue_head > queue_tail)
+            ? (queue_head - queue_tail)
+            : (TELEMETRY_QUEUE_SIZE - queue_tail);
+        if (chunk > space) chunk = (uint16_t)space;
+        stdio_usb.out_chars((const char *)&queue[queue_tail], chunk);
+        queue_tail = (queue_tail + chunk) & TELEMETRY_QUEUE_MASK;
+    }
+}
+
+uint32_t telemetry_dropped() {
+    return frames_dropped;
+}
+
+void telemetry_boot() {
+    uint8_t p[1] = {TELEMETRY_SCHEMA_VERSION};
+    telemetry_emit(TLM_EVT_BOOT, p, sizeof(p));
+
+    // Identifica a placa nas sessões coletadas de várias unidades
+    pico_unique_board_id_t id;
+    pico_get_unique_board_id(&id);
+    telemetry_emit(TLM_EVT_BOARD_ID, id.id, PICO_UNIQUE_BOARD_ID_SIZE_BYTES);
+}
+
+void telemetry_level(uint8_t level, uint32_t round) {
+    uint8_t p[5];
+    p[0] = level;
+    put_u32(&p[1], round);
+    telemetry_emit(TLM_EVT_LEVEL, p, sizeof(p));
+}
+
+void telemetry_arrow(uint8_t index, uint8_t count, uint8_t direction, uint16_t time_ms) {
+    uint8_t p[5] = {index, count, direction};
+    put_u16(&p[3], time_ms);
+    telemetry_emit(TLM_EVT_ARROW, p, sizeof(p));
+}
+
+void telemetry_input_window(uint16_t time_ms) {
+    uint8_t p[2];
+    put_u16(p, time_ms);
+    telemetry_emit(TLM_EVT_INPUT_WINDOW, p, sizeof(p));
+}
+
+void telemetry_input(uint8_t index, uint8_t direction, uint8_t expected) {
+    uint8_t p[3] = {index, direction, expected};
+    telemetry_emit(TLM_EVT_INPUT, p, sizeof(p));
+}
+
+void telemetry_verdict(telemetry_result_t result, uint8_t lives) {
+    uint8_t p[2] = {(uint8_t)result, lives};
+    telemetry_emit(TLM_EVT_VERDICT, p, sizeof(p));
+}
+
+void telemetry_reaction(telemetry_result_t result, uint16_t time_ms) {
+    uint8_t p[3] = {(uint8_t)result};
+    put_u16(&p[1], time_ms);
+    telemetry_emit(TLM_EVT_REACTION, p, sizeof(p));
+}
+
+void telemetry_game_over(uint32_t round, uint8_t level, uint16_t time_ms) {
+    uint8_t p[7];
+    put_u32(p, round);
+    p[4] = level;
+    put_u16(&p[5], time_ms);
+    telemetry_emit(TLM_EVT_GAME_OVER, p, sizeof(p));
+}
+
+void telemetry_arrow_onset(uint8_t index, uint32_t offset_us, int32_t jitter_us) {
+    uint8_t p[7];
+    if (jitter_us > INT16_MAX) jitter_us = INT16_MAX;
+    if (jitter_us < INT16_MIN) jitter_us = INT16_MIN;
+    p[0] = index;
+    put_u32(&p[1], offset_us);
+    put_u16(&p[5], (uint16_t)(int16_t)jitter_us);
+    telemetry_emit(TLM_EVT_ARROW_ONSET, p, sizeof(p));
+}
+
+void telemetry_joy_sample(uint16_t raw_x, uint16_t raw_y, uint8_t direction, uint8_t confidence) {
+    uint8_t p[6];
+    put_u16(p, raw_x);
+    put_u16(&p[2], raw_y);
+    p[4] = direction;
+    p[5] = confidence;
+    telemetry_emit(TLM_EVT_JOY_SAMPLE, p, sizeof(p));
+}
+
+void telemetry_metric(telemetry_metric_t metric, uint32_t value) {
+    uint8_t p[5] = {(uint8_t)metric};
+    put_u32(&p[1], value);
+    telemetry_emit(TLM_EVT_METRIC, p, sizeof(p));
+}
@@ -0,0 +1,90 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Telemetria binária sobre USB CDC.
+//
+// Cada evento vira um quadro:
+//   [versão u8][tipo u8][seq u16][t_us u32][payload...][crc8]
+// codificado em COBS e terminado por 0x00. Campos multibyte em little-endian.
+// O CRC-8 (polinômio 0x07) cobre tudo antes dele. O seq incrementa também
+// nos quadros descartados, então o host detecta perdas por lacunas.
+//
+// Os quadros vão para uma fila circular em RAM; telemetry_task() esvazia a
+// fila somente no espaço livre do CDC, sem nunca bloquear. Fila cheia descarta
+// o quadro novo.
+//
+// Versionamento: dentro da mesma versão só se acrescentam tipos de evento e
+// métricas novos; o payload de um tipo existente nunca muda. O decodificador
+// pula tipos que não conhece (ainda conferindo CRC e seq). Mudar ou remover
+// um payload exige incrementar TELEMETRY_SCHEMA_VERSION.
+//
+// telemetry_boot() deve ser o primeiro evento após telemetry_init(): o seq
+// recomeça em 0 a cada boot e o host usa o BOOT para detectar a reinicialização.
+//
+// Decodificador no host: tools/telemetry_decode.py
+
+#define TELEMETRY_SCHEMA_VERSION 1
+#define TELEMETRY_QUEUE_SIZE 1024 // Potência de 2
+#define TELEMETRY_MAX_PAYLOAD 16
+
+typedef enum {
+    TLM_EVT_BOOT = 0x01,         // schema u8
+    TLM_EVT_LEVEL = 0x02,        // level u8, round u32
+    TLM_EVT_ARROW = 0x03,        // index u8, count u8, direction u8, time_ms u16
+    TLM_EVT_INPUT_WINDOW = 0x04, // time_ms u16
+    TLM_EVT_INPUT = 0x05,        // index u8, direction u8, expected u8
+    TLM_EVT_VERDICT = 0x06,      // result u8, lives u8
+    TLM_EVT_REACTION = 0x07,     // result u8, time_ms u16
+    TLM_EVT_GAME_OVER = 0x08,    // round u32, level u8, time_ms u16
+    TLM_EVT_JOY_SAMPLE = 0x09,   // raw_x u16, raw_y u16, direction u8, confidence u8
+    TLM_EVT_ARROW_ONSET = 0x0A,  // index u8, offset_us u32, jitter_us i16
+    TLM_EVT_BOARD_ID = 0x0B,     // id u8[8] (ID único do flash); segue o BOOT
+    TLM_EVT_METRIC = 0x10        // metric u8, value u32
+} telemetry_event_t;
+
+typedef enum {
+    TLM_RESULT_SUCCESS = 0,
+    TLM_RESULT_WRONG = 1,
+    TLM_RESULT_TIMEOUT = 2
+} telemetry_result_t;
+
+typedef enum {
+    TLM_METRIC_DROPPED_FRAMES = 0x01,
+    TLM_METRIC_MATRIX_FRAMES = 0x02,  // Frames enviados à matriz na entrada
+    TLM_METRIC_MATRIX_SKIPPED = 0x03, // Frames redundantes evitados
+    TLM_METRIC_OLED_FRAMES = 0x04,
+    TLM_METRIC_OLED_SKIPPED = 0x05,
+    TLM_METRIC_SCREEN_CACHE_BYTES = 0x06, // RAM usada pelas telas em cache
+    TLM_METRIC_CLOCK_PROFILE = 0x07,      // Perfil ativo; precede as medidas abaixo
+    TLM_METRIC_SYS_CLOCK_KHZ = 0x08,
+    TLM_METRIC_I2C_HZ = 0x09,
+    TLM_METRIC_OLED_FLUSH_US = 0x0A,      // Envio de um frame completo ao OLED
+    TLM_METRIC_MATRIX_RENDER_US = 0x0B,   // Seta renderizada e copiada para o DMA
+    TLM_METRIC_INPUT_LATENCY_AVG_US = 0x0C, // IRQ do botão até a entrada ser tratada
+    TLM_METRIC_INPUT_LATENCY_MAX_US = 0x0D,
+    TLM_METRIC_OLED_RENDER_US = 0x0E,     // Montagem da tela de nível no buffer
+    TLM_METRIC_PRESENTER_FALLBACK = 0x0F  // Sequência apresentada sem alarme de hardware
+} telemetry_metric_t;
+
+void telemetry_init();
+void telemetry_task();
+void telemetry_emit(telemetry_event_t type, const uint8_t *payload, size_t len);
+uint32_t telemetry_dropped();
+
+void telemetry_boot();
+void telemetry_level(uint8_t level, uint32_t round);
+void telemetry_arrow(uint8_t index, uint8_t count, uint8_t direction, uint16_t time_ms);
+void telemetry_input_window(uint16_t time_ms);
+void telemetry_input(uint8_t index, uint8_t direction, uint8_t expected);
+void telemetry_verdict(telemetry_result_t result, uint8_t lives);
+void telemetry_reaction(telemetry_result_t result, uint16_t time_ms);
+void telemetry_game_over(uint32_t round, uint8_t level, uint16_t time_ms);
+void telemetry_arrow_onset(uint8_t index, uint32_t offset_us, int32_t jitter_us);
+void telemetry_joy_sample(uint16_t raw_x, uint16_t raw_y, uint8_t direction, uint8_t confidence);
+void telemetry_metric(telemetry_metric_t metric, uint32_t value);
+
+#endif
@@ -0,0 +1,204 @@
+// Fuzzer das regras do jogo (lib/game_core.c): os bytes de entrada viram
+// direções e tempos de cada passo, e as invariantes de
+// tools/game_invariants.h são verificadas a cada passo.
+//
+// Com libFuzzer:
+//   clang -g -O1 -fsanitize=fuzzer,address,undefined -DGAME_FUZZ_LIBFUZZER
+//         -Ilib tools/game_fuzz.c lib/game_core.c -o game_fuzz
+//   ./game_fuzz -max_len=4096
+//
+// Sem libFuzzer, o mesmo alvo roda um laço de propriedades com entradas
+// pseudoaleatórias a partir de uma semente, ou reproduz arquivos:
+//   cc -O2 -Ilib tools/game_fuzz.c lib/game_core.c -o game_fuzz
+//   ./game_fuzz [iterações] [semente]
+//   ./game_fuzz caso1.bin caso2.bin
+//
+// Formato da entrada:
+//   [semente u32] e depois, por rodada, um cabeçalho h:
+//     h & 0x80   rodada rápida: acerta tudo; o tempo total é
+//                (h & 0x7F) / 120 do limite, então acima de 120 estoura
+//     senão      um byte por passo s até completar a sequência:
+//                  s & 0x04  erra: direção = s & 3 (certa se coincidir)
+//                  senão     direção certa
+//                  s >> 3    tempo desde o passo anterior, em 1/16 do
+//                            limite dividido pelo tamanho da sequência
+//                um byte extra tenta entrar além da sequência
+// A entrada acaba quando os bytes acabam ou no fim de jogo.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "game_core.h"
+#include "game_invariants.h"
+
+#define FUZZ_MAX_ROUNDS 4096
+
+static void fail(const GameState *game, const char *what) {
+  fprintf(stderr, "invariante violada: %s (rodada %u, nível %u, vidas %u, passos %u/%u)\n",
+          what, game->rounds, game->difficulty_level, game->lives, game->player_steps, game->sequence_length);
+  abort();
+}
+
+static void check(const GameState *game) {
+  const char *violation = game_invariant_violation(game);
+  if (violation) fail(game, violation);
+}
+
+// Nível mais alto alcançado, para o resumo do laço de propriedades
+static uint8_t best_level;
+
+static void run_input(const uint8_t *data, size_t size) {
+  if (size < 4) return;
+  GameState game;
+  game_reset(&game);
+  check(&game);
+  uint32_t seed = data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+  size_t pos = 4;
+
+  for (uint32_t round = 0; round < FUZZ_MAX_ROUNDS && pos < size && !game.game_over; round++) {
+    game_generate_sequence(&game, seed + round);
+    check(&game);
+
+    uint8_t header = data[pos++];
+    uint8_t length = game.sequence_length;
+    uint32_t limit = game_time_limit_ms(&game);
+    uint32_t elapsed = 0;
+    bool wrong = false;
+    bool timed_out = false;
+    uint8_t level = game.difficulty_level;
+    uint32_t limit_before = limit;
+    uint8_t lives = game.lives;
+
+    game.player_steps = 0;
+    if (header & 0x80) {
+      uint32_t total = limit * (header & 0x7F) / 120;
+      for (uint8_t i = 0; i < length; i++) {
+        elapsed = total * (i + 1) / length;
+        if (game_input_timed_out(&game, elapsed)) {
+          timed_out = true;
+          break;
+        }
+        if (!game_record_input(&game, game.sequence[i])) fail(&game, "entrada recusada antes do fim da sequência");
+        check(&game);
+      }
+    } else {
+      while (!game_input_complete(&game)) {
+        if (pos >= size) return; // Entrada acabou no meio da rodada
+        uint8_t step = data[pos++];
+        elapsed += (step >> 3) * limit / (16 * length);
+        if (game_input_timed_out(&game, elapsed)) {
+          timed_out = true;
+          break;
+        }
+        uint8_t expected = game.sequence[game.player_steps];
+        uint8_t direction = (step & 0x04) ? (step & 3) : expected;
+        if (direction != expected) wrong = true;
+        if (!game_record_input(&game, direction)) fail(&game, "entrada recusada antes do fim da sequência");
+        check(&game);
+      }
+      if (!timed_out && pos < size) {
+        if (game_record_input(&game, data[pos++] & 3)) fail(&game, "entrada aceita além da sequência");
+        check(&game);
+      }
+    }
+
+    game_verdict_t verdict = game_finish_round(&game, timed_out);
+    check(&game);
+    game_verdict_t expected = timed_out ? GAME_VERDICT_TIMEOUT : wrong ? GAME_VERDICT_WRONG : GAME_VERDICT_SUCCESS;
+    if (verdict != expected) fail(&game, "veredito diferente do esperado");
+    if (game.lives != (verdict == GAME_VERDICT_SUCCESS ? lives : lives - 1))
+      fail(&game, "vidas não caíram exatamente uma vez no erro");
+    if (game.game_over) break;
+
+    uint32_t rounds = game.rounds;
+    game_advance(&game);
+    check(&game);
+    if (game.rounds != rounds + 1) fail(&game, "rodada não avançou uma vez");
+    if (game.difficulty_level < level) fail(&game, "nível regrediu");
+    if (game_time_limit_ms(&game) > limit_before) fail(&game, "limite de tempo cresceu com o nível");
+    if (game.difficulty_level > best_level) best_level = game.difficulty_level;
+  }
+}
+
+#ifdef GAME_FUZZ_LIBFUZZER
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  run_input(data, size);
+  return 0;
+}
+
+#else
+
+#define PROPERTY_MAX_INPUT 8192
+
+static uint32_t rng_state;
+
+static uint32_t next_random() {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+// Maioria de rodadas rápidas dentro do prazo, para chegar a níveis altos,
+// misturadas a rodadas passo a passo com erros e tempos perto do limite.
+// Uma em oito entradas só acerta, para levar o nível até a saturação.
+static size_t random_input(uint8_t *buf) {
+  size_t size = 4 + next_random() % (PROPERTY_MAX_INPUT - 4);
+  bool clean = next_random() % 8 == 0;
+  for (size_t i = 0; i < 4; i++) buf[i] = (uint8_t)next_random();
+  size_t pos = 4;
+  while (pos < size) {
+    uint32_t kind = clean ? 0 : next_random() % 100;
+    if (kind < 97) {
+      buf[pos++] = 0x80 | (uint8_t)(next_random() % 118);
+    } else if (kind < 98) {
+      buf[pos++] = 0x80 | (uint8_t)(115 + next_random() % 13); // Perto do prazo
+    } else {
+      buf[pos++] = 0x00;
+      for (uint8_t i = 0; i <= MAX_SEQUENCE && pos < size; i++) {
+        uint8_t delay = (uint8_t)(next_random() % 32);
+        uint8_t wrong = (next_random() % 16 == 0) ? 0x04 : 0;
+        buf[pos++] = (uint8_t)((delay << 3) | wrong | (next_random() & 3));
+      }
+    }
+  }
+  return size;
+}
+
+static int run_file(const char *path) {
+  static uint8_t buf[1 << 20];
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    perror(path);
+    return 1;
+  }
+  size_t size = fread(buf, 1, sizeof(buf), f);
+  fclose(f);
+  run_input(buf, size);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1 && strtoul(argv[1], NULL, 10) == 0) {
+    for (int i = 1; i < argc; i++) {
+      if (run_file(argv[i])) return 1;
+    }
+    fprintf(stderr, "%d entradas sem violação\n", argc - 1);
+    return 0;
+  }
+
+  static uint8_t buf[PROPERTY_MAX_INPUT];
+  uint32_t iterations = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 2000;
+  uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : 1;
+  rng_state = seed ? seed : 1;
+  for (uint32_t i = 0; i < iterations; i++) run_input(buf, random_input(buf));
+  fprintf(stderr, "semente %u  iterações: %u  melhor nível: %u\n", seed, iterations, best_level);
+  // Sem chegar a MAX_LEVEL o clamp da sequência e a saturação do nível não
+  // foram exercitados
+  return best_level == MAX_LEVEL ? 0 : 3;
+}
+
+#endif
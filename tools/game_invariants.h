@@ -0,0 +1,31 @@
+#ifndef GAME_INVARIANTS_H
+#define GAME_INVARIANTS_H
+
+// Invariantes do estado de lib/game_core.c, compartilhadas por
+// tools/game_sim.c e tools/game_fuzz.c. Retorna NULL se o estado é válido
+// ou a descrição da primeira violação.
+
+#include "game_core.h"
+
+static inline const char *game_invariant_violation(const GameState *game) {
+  if (game->lives > START_LIVES) return "vidas acima do inicial";
+  if (game->game_over != (game->lives == 0)) return "game_over fora de sincronia com vidas";
+  if (game->sequence_length == 0 || game->sequence_length > MAX_SEQUENCE)
+    return "tamanho da sequência fora de 1..MAX_SEQUENCE";
+  if (game->player_steps > game->sequence_length) return "passos além da sequência";
+  if (game->difficulty_level == 0) return "nível zero";
+  if (game->sequence_length != (game->difficulty_level < MAX_SEQUENCE ? game->difficulty_level : MAX_SEQUENCE))
+    return "tamanho da sequência não segue o nível";
+  for (uint8_t i = 0; i < game->sequence_length; i++) {
+    if (game->sequence[i] > 3) return "direção inválida na sequência";
+  }
+  uint32_t limit = game_time_limit_ms(game);
+  uint32_t arrow = game_arrow_display_ms(game);
+  uint32_t reaction = game_reaction_ms(game);
+  if (limit < MIN_TIME_LIMIT_MS || limit > BASE_TIME_LIMIT_MS) return "limite de tempo fora da faixa";
+  if (arrow < MIN_ARROW_DISPLAY_MS || arrow > BASE_ARROW_DISPLAY_MS) return "tempo de seta fora da faixa";
+  if (reaction < MIN_REACTION_MS || reaction > BASE_REACTION_MS) return "tempo de reação fora da faixa";
+  return NULL;
+}
+
+#endif
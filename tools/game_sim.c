@@ -0,0 +1,188 @@
+// Simulador das regras do jogo (lib/game_core.c) no host, sem hardware.
+//
+// Compilar:
+//   cc -O2 -Ilib tools/game_sim.c lib/game_core.c -o game_sim
+//
+// Uso:
+//   game_sim [modo] [partidas] [semente]
+//
+// Modos de jogador:
+//   perfect  acerta toda sequência dentro do tempo
+//   noisy    erra cada seta com 5% de chance e às vezes estoura o tempo
+//   random   erra ~0,5% das setas, tempo por seta aleatório (às vezes perto do
+//            limite) e entradas extras depois da sequência completa
+//   script   lê "d0 d1 ...|timeout" por rodada do stdin (0=cima 1=baixo 2=esq 3=dir)
+//
+// A cada passo as invariantes do estado (tools/game_invariants.h) são
+// verificadas; uma violação aborta com a semente e a rodada para reprodução.
+// Para entradas arbitrárias, ver tools/game_fuzz.c. No stderr sai um resumo
+// com partidas por segundo e a distribuição de níveis alcançados.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "game_core.h"
+#include "game_invariants.h"
+
+#define DEFAULT_GAMES 100000
+// Teto de rodadas por partida; o jogador perfeito nunca perde
+#define MAX_ROUNDS_PER_GAME 2000
+
+typedef enum {
+  PLAYER_PERFECT,
+  PLAYER_NOISY,
+  PLAYER_RANDOM,
+  PLAYER_SCRIPT
+} player_mode_t;
+
+static uint32_t sim_rng = 1;
+static uint32_t current_seed;
+static uint32_t current_game;
+
+static uint32_t sim_random() {
+  sim_rng ^= sim_rng << 13;
+  sim_rng ^= sim_rng >> 17;
+  sim_rng ^= sim_rng << 5;
+  return sim_rng;
+}
+
+static void fail(const GameState *game, const char *what) {
+  fprintf(stderr, "invariante violada: %s (semente %u, partida %u, rodada %u, nível %u, vidas %u)\n",
+          what, current_seed, current_game, game->rounds, game->difficulty_level, game->lives);
+  exit(2);
+}
+
+static void check(const GameState *game) {
+  const char *violation = game_invariant_violation(game);
+  if (violation) fail(game, violation);
+}
+
+// Lê a próxima rodada roteirizada; false no fim da entrada
+static bool script_round(uint8_t *inputs, uint8_t *count, bool *timeout) {
+  char line[256];
+  if (!fgets(line, sizeof(line), stdin)) return false;
+  *count = 0;
+  *timeout = strstr(line, "timeout") != NULL;
+  for (char *tok = strtok(line, " ,\t\r\n"); tok; tok = strtok(NULL, " ,\t\r\n")) {
+    if (*count >= 2 * MAX_SEQUENCE) break;
+    if (tok[0] >= '0' && tok[0] <= '3' && tok[1] == '\0') inputs[(*count)++] = (uint8_t)(tok[0] - '0');
+  }
+  return true;
+}
+
+// Joga uma rodada como o laço de player_input(); false se a entrada acabou
+static bool play_round(GameState *game, player_mode_t mode) {
+  uint8_t inputs[2 * MAX_SEQUENCE];
+  uint32_t delays[2 * MAX_SEQUENCE] = {0}; // ms desde a entrada anterior
+  uint8_t count = 0;
+  bool timeout = false;
+  uint32_t limit = game_time_limit_ms(game);
+
+  switch (mode) {
+    case PLAYER_PERFECT:
+      memcpy(inputs, game->sequence, game->sequence_length);
+      count = game->sequence_length;
+      break;
+    case PLAYER_NOISY:
+      for (uint8_t i = 0; i < game->sequence_length; i++)
+        inputs[i] = (sim_random() % 100 < 5) ? (uint8_t)(sim_random() % 4) : game->sequence[i];
+      count = game->sequence_length;
+      timeout = sim_random() % 100 < 2;
+      break;
+    case PLAYER_RANDOM: {
+      // Rodadas lentas gastam em média o limite inteiro e cruzam o prazo
+      // em cerca de metade das vezes
+      uint32_t budget = (sim_random() % 20 == 0 ? 2 : 1) * limit / game->sequence_length;
+      count = game->sequence_length + (uint8_t)(sim_random() % (MAX_SEQUENCE + 1));
+      for (uint8_t i = 0; i < count; i++) {
+        inputs[i] = (sim_random() % 200 < 1) ? (uint8_t)(sim_random() % 4) : game->sequence[i % game->sequence_length];
+        delays[i] = sim_random() % (budget + 1);
+      }
+      break;
+    }
+    case PLAYER_SCRIPT:
+      if (!script_round(inputs, &count, &timeout)) return false;
+      break;
+  }
+
+  if (timeout) {
+    for (uint8_t i = 0; i < count; i++) delays[i] = limit / count + 1;
+  }
+
+  game->player_steps = 0;
+  uint32_t elapsed = 0;
+  uint8_t i = 0;
+  for (; i < count && !game_input_complete(game); i++) {
+    elapsed += delays[i];
+    if (game_input_timed_out(game, elapsed)) break;
+    if (!game_record_input(game, inputs[i])) fail(game, "entrada recusada antes do fim da sequência");
+    check(game);
+  }
+  // Entradas que sobram depois da sequência completa devem ser recusadas
+  for (; i < count && game_input_complete(game); i++) {
+    if (game_record_input(game, inputs[i])) fail(game, "entrada aceita além da sequência");
+    check(game);
+  }
+  // Entrada incompleta só termina por tempo, como no firmware
+  bool timed_out = !game_input_complete(game) || game_input_timed_out(game, elapsed);
+  game_verdict_t verdict = game_finish_round(game, timed_out);
+  if (verdict > GAME_VERDICT_TIMEOUT) fail(game, "veredito desconhecido");
+  check(game);
+  if (!game->game_over) {
+    game_advance(game);
+    check(game);
+  }
+  return true;
+}
+
+static player_mode_t parse_mode(const char *name) {
+  if (strcmp(name, "perfect") == 0) return PLAYER_PERFECT;
+  if (strcmp(name, "noisy") == 0) return PLAYER_NOISY;
+  if (strcmp(name, "script") == 0) return PLAYER_SCRIPT;
+  return PLAYER_RANDOM;
+}
+
+int main(int argc, char **argv) {
+  player_mode_t mode = argc > 1 ? parse_mode(argv[1]) : PLAYER_RANDOM;
+  uint32_t games = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : DEFAULT_GAMES;
+  current_seed = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 10) : (uint32_t)time(NULL);
+  sim_rng = current_seed ? current_seed : 1;
+  if (mode == PLAYER_SCRIPT) games = 1;
+
+  uint32_t level_hist[MAX_LEVEL + 1] = {0};
+  uint64_t total_rounds = 0;
+  uint8_t best_level = 0;
+
+  struct timespec t0, t1;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  for (current_game = 0; current_game < games; current_game++) {
+    GameState game;
+    game_reset(&game);
+    check(&game);
+    for (uint32_t round = 0; round < MAX_ROUNDS_PER_GAME && !game.game_over; round++) {
+      game_generate_sequence(&game, sim_random());
+      check(&game);
+      if (!play_round(&game, mode)) break;
+    }
+    total_rounds += game.rounds;
+    level_hist[game.difficulty_level]++;
+    if (game.difficulty_level > best_level) best_level = game.difficulty_level;
+    if (mode == PLAYER_SCRIPT)
+      printf("rodadas %u nível %u vidas %u%s\n", game.rounds, game.difficulty_level, game.lives,
+             game.game_over ? " fim de jogo" : "");
+  }
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  double secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+  printf("nivel,partidas\n");
+  for (uint32_t level = 1; level <= best_level; level++) {
+    if (level_hist[level]) printf("%u,%u\n", level, level_hist[level]);
+  }
+  fprintf(stderr, "semente %u  partidas: %u  rodadas: %llu  melhor nível: %u  %.0f partidas/s\n",
+          current_seed, games, (unsigned long long)total_rounds, best_level,
+          secs > 0 ? games / secs : 0.0);
+  return 0;
+}
@@ -0,0 +1,207 @@
+// Reproduz traços de ADC gravados pelo pipeline do joystick no host.
+//
+// Compilar:
+//   cc -O2 -Ilib tools/joy_replay.c lib/joystick.c -o joy_replay
+//
+// Entrada: CSV com colunas raw_x e raw_y (saída de tools/telemetry_decode.py
+// com o firmware compilado com -DJOYSTICK_TRACE=ON no CMake) ou linhas "x,y" simples.
+// As primeiras amostras calibram o centro, como no boot do jogo.
+//
+// Saída: CSV por amostra (omitido com -q) e, no stderr, um resumo com trocas
+// de direção e o custo médio por amostra.
+//
+// Linhas começando com '#' são comentários. Um traço pode declarar o
+// resultado esperado, e a saída é 2 se o pipeline divergir:
+//   # esperado: none,up,none   sequência de direções sem repetições seguidas
+//   # trocas: 2                número de trocas de direção
+// Os traços de referência ficam em tools/traces/.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "joystick.h"
+
+#define MAX_SAMPLES 200000
+#define CALIBRATION_SAMPLES 32
+#define MAX_EXPECTED 64
+
+static uint16_t trace_x[MAX_SAMPLES];
+static uint16_t trace_y[MAX_SAMPLES];
+
+// Resultado declarado no traço
+static joy_direction_t expected[MAX_EXPECTED];
+static size_t expected_count;
+static long expected_changes = -1;
+
+static const char *dir_name(joy_direction_t dir) {
+  switch (dir) {
+    case JOY_DIR_UP: return "up";
+    case JOY_DIR_DOWN: return "down";
+    case JOY_DIR_LEFT: return "left";
+    case JOY_DIR_RIGHT: return "right";
+    default: return "none";
+  }
+}
+
+static bool parse_direction(const char *name, joy_direction_t *dir) {
+  static const joy_direction_t dirs[] = {JOY_DIR_UP, JOY_DIR_DOWN, JOY_DIR_LEFT, JOY_DIR_RIGHT, JOY_DIR_NONE};
+  for (size_t i = 0; i < sizeof(dirs) / sizeof(dirs[0]); i++) {
+    if (strcmp(name, dir_name(dirs[i])) == 0) {
+      *dir = dirs[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+// Lê "# esperado: ..." e "# trocas: N"; false se a expectativa for inválida
+static bool parse_comment(char *line) {
+  char *p = line + 1;
+  while (*p == ' ') p++;
+  if (strncmp(p, "esperado:", 9) == 0) {
+    expected_count = 0;
+    for (char *tok = strtok(p + 9, " ,\r\n"); tok; tok = strtok(NULL, " ,\r\n")) {
+      if (expected_count >= MAX_EXPECTED || !parse_direction(tok, &expected[expected_count])) return false;
+      expected_count++;
+    }
+  } else if (strncmp(p, "trocas:", 7) == 0) {
+    char *end;
+    expected_changes = strtol(p + 7, &end, 10);
+    if (end == p + 7 || expected_changes < 0) return false;
+  }
+  return true;
+}
+
+// Índice da coluna com o nome dado no cabeçalho, ou -1
+static int column_index(char *header, const char *name) {
+  int index = 0;
+  for (char *tok = strtok(header, ",\r\n"); tok; tok = strtok(NULL, ",\r\n"), index++) {
+    if (strcmp(tok, name) == 0) return index;
+  }
+  return -1;
+}
+
+static bool field_at(const char *line, int column, long *value) {
+  const char *p = line;
+  for (int i = 0; i < column; i++) {
+    p = strchr(p, ',');
+    if (!p) return false;
+    p++;
+  }
+  char *end;
+  *value = strtol(p, &end, 10);
+  return end != p;
+}
+
+int main(int argc, char **argv) {
+  bool quiet = argc > 1 && strcmp(argv[1], "-q") == 0;
+  const char *path = argc > 1 + quiet ? argv[1 + quiet] : "-";
+  FILE *in = stdin;
+  if (strcmp(path, "-") != 0) {
+    in = fopen(path, "r");
+    if (!in) {
+      perror(path);
+      return 1;
+    }
+  }
+
+  char line[512];
+  int col_x = 0, col_y = 1;
+  size_t count = 0;
+  bool first = true;
+  while (fgets(line, sizeof(line), in) && count < MAX_SAMPLES) {
+    if (line[0] == '#') {
+      if (!parse_comment(line)) {
+        fprintf(stderr, "expectativa inválida: %s", line);
+        return 1;
+      }
+      continue;
+    }
+    if (first) {
+      first = false;
+      if (strstr(line, "raw_x")) {
+        char header[512];
+        strcpy(header, line);
+        col_x = column_index(header, "raw_x");
+        strcpy(header, line);
+        col_y = column_index(header, "raw_y");
+        continue;
+      }
+    }
+    long x, y;
+    if (!field_at(line, col_x, &x) || !field_at(line, col_y, &y)) continue;
+    if (x < 0 || x > JOY_ADC_MAX || y < 0 || y > JOY_ADC_MAX) continue;
+    trace_x[count] = (uint16_t)x;
+    trace_y[count] = (uint16_t)y;
+    count++;
+  }
+  if (in != stdin) fclose(in);
+  if (count == 0) {
+    fprintf(stderr, "nenhuma amostra\n");
+    return 1;
+  }
+
+  joystick_t js;
+  size_t cal = count < CALIBRATION_SAMPLES ? count : CALIBRATION_SAMPLES;
+  uint32_t sum_x = 0, sum_y = 0;
+  for (size_t i = 0; i < cal; i++) {
+    sum_x += trace_x[i];
+    sum_y += trace_y[i];
+  }
+  joystick_calibrate(&js, sum_x / cal, sum_y / cal);
+
+  if (!quiet) printf("sample,raw_x,raw_y,filt_x,filt_y,norm_x,norm_y,direction,confidence\n");
+  joy_direction_t last = JOY_DIR_NONE;
+  size_t changes = 0;
+  // Sequência observada, começando do centro solto
+  joy_direction_t observed[MAX_EXPECTED];
+  size_t observed_count = 1;
+  observed[0] = JOY_DIR_NONE;
+  for (size_t i = 0; i < count; i++) {
+    joy_direction_t dir = joystick_update(&js, trace_x[i], trace_y[i]);
+    if (dir != last) {
+      changes++;
+      if (observed_count < MAX_EXPECTED) observed[observed_count] = dir;
+      observed_count++;
+    }
+    last = dir;
+    if (!quiet) printf("%zu,%u,%u,%u,%u,%d,%d,%s,%u\n", i, trace_x[i], trace_y[i], js.filt_x, js.filt_y,
+           js.norm_x, js.norm_y, dir_name(dir), js.confidence);
+  }
+
+  // Custo do pipeline sem E/S
+  const int passes = 50;
+  struct timespec t0, t1;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  for (int p = 0; p < passes; p++) {
+    for (size_t i = 0; i < count; i++) joystick_update(&js, trace_x[i], trace_y[i]);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+
+  fprintf(stderr, "amostras: %zu  centro: %u,%u  trocas de direção: %zu  custo: %.1f ns/amostra\n",
+          count, js.center_x, js.center_y, changes, ns / ((double)count * passes));
+
+  bool mismatch = false;
+  if (expected_changes >= 0 && (size_t)expected_changes != changes) {
+    fprintf(stderr, "trocas esperadas: %ld  obtidas: %zu\n", expected_changes, changes);
+    mismatch = true;
+  }
+  if (expected_count > 0) {
+    bool same = expected_count == observed_count;
+    for (size_t i = 0; same && i < expected_count; i++) same = expected[i] == observed[i];
+    if (!same) {
+      fprintf(stderr, "sequência esperada:");
+      for (size_t i = 0; i < expected_count; i++) fprintf(stderr, "%s%s", i ? "," : " ", dir_name(expected[i]));
+      fprintf(stderr, "\nsequência obtida:  ");
+      size_t shown = observed_count < MAX_EXPECTED ? observed_count : MAX_EXPECTED;
+      for (size_t i = 0; i < shown; i++) fprintf(stderr, "%s%s", i ? "," : " ", dir_name(observed[i]));
+      fprintf(stderr, "%s\n", observed_count > shown ? ",..." : "");
+      mismatch = true;
+    }
+  }
+  return mismatch ? 2 : 0;
+}
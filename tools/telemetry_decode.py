@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+"""Decodifica a telemetria binária do Jogo de Setas para CSV.
+
+Uso:
+    telemetry_decode.py /dev/ttyACM0 > sessao.csv   (requer pyserial)
+    telemetry_decode.py captura.bin > sessao.csv
+    cat captura.bin | telemetry_decode.py - > sessao.csv
+
+Formato do quadro (ver lib/telemetry.h), antes do COBS:
+    [versão u8][tipo u8][seq u16][t_us u32][payload...][crc8]
+
+Tipos de evento desconhecidos são aditivos na mesma versão do schema: o
+quadro é validado e contado, mas não vira linha no CSV.
+"""
+
+import csv
+import struct
+import sys
+
+SCHEMA_VERSION = 1
+
+# tipo -> (nome, formato struct do payload, campos)
+EVENTS = {
+    0x01: ("boot", "<B", ("schema",)),
+    0x02: ("level", "<BI", ("level", "round")),
+    0x03: ("arrow", "<BBBH", ("index", "count", "direction", "time_ms")),
+    0x04: ("input_window", "<H", ("time_ms",)),
+    0x05: ("input", "<BBB", ("index", "direction", "expected")),
+    0x06: ("verdict", "<BB", ("result", "lives")),
+    0x07: ("reaction", "<BH", ("result", "time_ms")),
+    0x08: ("game_over", "<IBH", ("round", "level", "time_ms")),
+    0x09: ("joy_sample", "<HHBB", ("raw_x", "raw_y", "direction", "confidence")),
+    0x0A: ("arrow_onset", "<BIh", ("index", "offset_us", "jitter_us")),
+    0x0B: ("board_id", "<8s", ("board",)),
+    0x10: ("metric", "<BI", ("metric", "value")),
+}
+
+RESULTS = {0: "success", 1: "wrong", 2: "timeout"}
+METRICS = {
+    0x01: "dropped_frames",
+    0x02: "matrix_frames",
+    0x03: "matrix_skipped",
+    0x04: "oled_frames",
+    0x05: "oled_skipped",
+    0x06: "screen_cache_bytes",
+    0x07: "clock_profile",
+    0x08: "sys_clock_khz",
+    0x09: "i2c_hz",
+    0x0A: "oled_flush_us",
+    0x0B: "matrix_render_us",
+    0x0C: "input_latency_avg_us",
+    0x0D: "input_latency_max_us",
+    0x0E: "oled_render_us",
+    0x0F: "presenter_fallback",
+}
+PROFILES = {0: "power_save", 1: "default", 2: "performance"}
+
+COLUMNS = ["seq", "t_us", "event", "level", "round", "index", "count",
+           "direction", "expected", "time_ms", "result", "lives",
+           "metric", "value", "raw_x", "raw_y", "confidence", "offset_us",
+           "jitter_us", "schema", "board", "profile", "lost"]
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data) + 1:
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def decode_frame(encoded):
+    """Retorna a linha do quadro, None se inválido ou a linha sem "event" se o
+    tipo for desconhecido."""
+    raw = cobs_decode(encoded)
+    if raw is None or len(raw) < 9 or crc8(raw[:-1]) != raw[-1]:
+        return None
+    version, kind, seq, t_us = struct.unpack_from("<BBHI", raw)
+    if version != SCHEMA_VERSION:
+        return None
+    if kind not in EVENTS:
+        return {"seq": seq, "t_us": t_us}
+    name, fmt, fields = EVENTS[kind]
+    payload = raw[8:-1]
+    if len(payload) != struct.calcsize(fmt):
+        return None
+    row = {"seq": seq, "t_us": t_us, "event": name}
+    row.update(zip(fields, struct.unpack(fmt, payload)))
+    if "result" in row:
+        row["result"] = RESULTS.get(row["result"], row["result"])
+    if "metric" in row:
+        row["metric"] = METRICS.get(row["metric"], row["metric"])
+    if "board" in row:
+        row["board"] = row["board"].hex().upper()
+    return row
+
+
+def open_source(path):
+    if path == "-":
+        return sys.stdin.buffer
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial
+        return serial.Serial(path, timeout=None)
+    return open(path, "rb")
+
+
+def main(argv):
+    if len(argv) != 2:
+        sys.stderr.write(__doc__)
+        return 1
+    source = open_source(argv[1])
+    writer = csv.DictWriter(sys.stdout, fieldnames=COLUMNS)
+    writer.writeheader()
+
+    buffer = bytearray()
+    last_seq = None
+    profile = None
+    board = None
+    bad = 0
+    unknown = 0
+    pending_lost = 0
+    while True:
+        chunk = source.read(1) if hasattr(source, "in_waiting") else source.read(4096)
+        if not chunk:
+            break
+        buffer += chunk
+        while True:
+            end = buffer.find(0)
+            if end < 0:
+                break
+            encoded = bytes(buffer[:end])
+            del buffer[:end + 1]
+            if not encoded:
+                continue
+            row = decode_frame(encoded)
+            if row is None:
+                bad += 1
+                continue
+            # Reinicialização: o seq recomeça e o estado da sessão anterior
+            # não vale mais
+            if row.get("event") == "boot":
+                last_seq = None
+                pending_lost = 0
+                profile = None
+                board = None
+            # Lacunas no seq indicam quadros descartados na fila do firmware
+            if last_seq is not None:
+                row["lost"] = pending_lost + ((row["seq"] - last_seq - 1) & 0xFFFF)
+            last_seq = row["seq"]
+            # Tipo desconhecido: perdas antes dele passam para a próxima linha
+            if "event" not in row:
+                unknown += 1
+                pending_lost = row.get("lost", 0)
+                continue
+            pending_lost = 0
+            # Cada linha leva o último perfil de clock anunciado
+            if row.get("metric") == "clock_profile":
+                profile = PROFILES.get(row["value"], row["value"])
+            row["profile"] = profile
+            # Cada linha leva a placa de origem, anunciada logo após o boot
+            if row["event"] == "board_id":
+                board = row["board"]
+            row["board"] = board
+            writer.writerow(row)
+        sys.stdout.flush()
+
+    if bad:
+        sys.stderr.write("%d quadros inválidos ignorados\n" % bad)
+    if unknown:
+        sys.stderr.write("%d quadros de tipo desconhecido pulados\n" % unknown)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))